@@ -0,0 +1,141 @@
+#define ALICE_NO_ENTRY_POINT 1
+#include "main.cpp"
+
+#ifdef _WIN64
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+// Runs the simulation without a window, OpenGL or sound, for soak tests and for comparing performance between builds.
+// The scenario (and save, if one is given) are looked up in the usual scenario and save game directories.
+
+static uint64_t peak_resident_bytes() {
+#ifdef _WIN64
+	PROCESS_MEMORY_COUNTERS counters{};
+	if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return uint64_t(counters.PeakWorkingSetSize);
+	return 0;
+#else
+	rusage usage{};
+	if(getrusage(RUSAGE_SELF, &usage) == 0)
+		return uint64_t(usage.ru_maxrss) * 1024; // reported in kilobytes
+	return 0;
+#endif
+}
+
+static void print_usage(char const* name) {
+	std::printf("Usage: %s <scenario file> [options]\n", name);
+	std::printf("  --save <file>     continue from a save game instead of the scenario start\n");
+	std::printf("  --days <n>        number of days to simulate (default 365)\n");
+	std::printf("  --seed <n>        game seed, so that runs can be compared (default 808080)\n");
+	std::printf("  --profile         print the time taken by each phase of the tick at the end\n");
+	std::printf("  --ecodump <fmt>   record the economy of every day to the data dumps directory, as bin or csv\n");
+}
+
+int main(int argc, char** argv) {
+	if(argc <= 1) {
+		print_usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::string scenario_name = argv[1];
+	std::string save_name;
+	int32_t days = 365;
+	uint32_t seed = 808080;
+	bool profile = false;
+	bool ecodump = false;
+	bool ecodump_csv = false;
+
+	for(int32_t i = 2; i < argc; ++i) {
+		auto arg = std::string_view{ argv[i] };
+		if(arg == "--save" && i + 1 < argc) {
+			save_name = argv[++i];
+		} else if(arg == "--days" && i + 1 < argc) {
+			days = int32_t(std::strtol(argv[++i], nullptr, 10));
+		} else if(arg == "--seed" && i + 1 < argc) {
+			seed = uint32_t(std::strtoul(argv[++i], nullptr, 10));
+		} else if(arg == "--profile") {
+			profile = true;
+		} else if(arg == "--ecodump" && i + 1 < argc && (argv[i + 1] == std::string_view{ "bin" } || argv[i + 1] == std::string_view{ "csv" })) {
+			ecodump = true;
+			ecodump_csv = argv[++i] == std::string_view{ "csv" };
+		} else {
+			print_usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::unique_ptr<sys::state> game_state = std::make_unique<sys::state>(); // too big for the stack
+	add_root(game_state->common_fs, NATIVE("."));
+
+	auto load_start = std::chrono::steady_clock::now();
+	if(!sys::try_read_scenario_and_save_file(*game_state, simple_fs::utf8_to_native(scenario_name))) {
+		std::fprintf(stderr, "Scenario file %s could not be read.\n", scenario_name.c_str());
+		return EXIT_FAILURE;
+	}
+	if(!save_name.empty()) {
+		game_state->preload();
+		if(!sys::try_read_save_file(*game_state, simple_fs::utf8_to_native(save_name))) {
+			std::fprintf(stderr, "Save file %s could not be read.\n", save_name.c_str());
+			return EXIT_FAILURE;
+		}
+	}
+	game_state->fill_unsaved_data();
+	auto load_end = std::chrono::steady_clock::now();
+
+	// every nation is left to the ai: there is nobody here to answer events or diplomatic requests
+	game_state->local_player_nation = dcon::nation_id{};
+	for(auto n : game_state->world.in_nation)
+		n.set_is_player_controlled(false);
+	game_state->user_settings.autosaves = sys::autosave_frequency::none;
+	game_state->game_seed = seed;
+
+	profiler::set_enabled(profile);
+	if(ecodump) {
+		economy_telemetry::start(*game_state);
+		game_state->cheat_data.ecodump = true;
+	}
+
+	auto start_ymd = game_state->current_date.to_ymd(game_state->start_date);
+	std::printf("Simulating %d days from %d.%d.%d with seed %u\n", int32_t(days), int32_t(start_ymd.year), int32_t(start_ymd.month), int32_t(start_ymd.day), seed);
+
+	auto run_start = std::chrono::steady_clock::now();
+	for(int32_t i = 0; i < days; ++i) {
+		game_state->single_game_tick();
+
+		// nothing reads the ui message queues, so they are emptied here to keep them from filling up
+		while(game_state->new_messages.front())
+			game_state->new_messages.pop();
+	}
+	auto run_end = std::chrono::steady_clock::now();
+
+	uint32_t dropped_days = 0;
+	if(ecodump) {
+		game_state->cheat_data.ecodump = false;
+		dropped_days = economy_telemetry::stop(*game_state, ecodump_csv);
+	}
+
+	auto load_seconds = std::chrono::duration<double>(load_end - load_start).count();
+	auto run_seconds = std::chrono::duration<double>(run_end - run_start).count();
+	auto end_ymd = game_state->current_date.to_ymd(game_state->start_date);
+	auto checksum = game_state->get_save_checksum();
+
+	std::printf("Reached %d.%d.%d\n", int32_t(end_ymd.year), int32_t(end_ymd.month), int32_t(end_ymd.day));
+	std::printf("Load time: %.3f s\n", load_seconds);
+	std::printf("Simulation time: %.3f s\n", run_seconds);
+	std::printf("Ticks per second: %.2f\n", run_seconds > 0.0 ? double(days) / run_seconds : 0.0);
+	std::printf("Peak resident memory: %.1f MB\n", double(peak_resident_bytes()) / (1024.0 * 1024.0));
+	std::printf("Checksum: %s\n", checksum.to_hex_string().c_str());
+
+	if(ecodump) {
+		auto dumps = simple_fs::get_or_create_data_dumps_directory();
+		std::printf("Economy dump: %s (%u days dropped)\n", simple_fs::native_to_utf8(simple_fs::get_full_name(dumps)).c_str(), dropped_days);
+	}
+	if(profile) {
+		std::printf("\n%s", profiler::summary_text().c_str());
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -11,6 +11,7 @@
 #include "prng.hpp"
 #include "province_templates.hpp"
 #include "triggers.hpp"
+#include "tick_profiler.hpp"
 
 namespace ai {
 
@@ -1124,165 +1125,78 @@ void update_ai_ruling_party(sys::state& state) {
 	}
 }
 
-void get_craved_factory_types(sys::state& state, dcon::nation_id nid, dcon::market_id mid, std::vector<dcon::factory_type_id>& desired_types) {
+void get_craved_factory_types(sys::state& state, dcon::nation_id nid, dcon::market_id mid, std::vector<dcon::factory_type_id>& desired_types, bool use_cached_scores) {
 	assert(desired_types.empty());
 	auto n = dcon::fatten(state.world, nid);
-	auto m = dcon::fatten(state.world, mid);
-	auto sid = m.get_zone_from_local_market();
 
 	auto const tax_eff = nations::tax_efficiency(state, n);
 	auto const rich_effect = (1.0f - tax_eff * float(state.world.nation_get_rich_tax(n)) / 100.0f);
 
-	if(desired_types.empty()) {
-		for(auto type : state.world.in_factory_type) {
-			if(n.get_active_building(type) || type.get_is_available_from_start()) {
-				float cost = economy::factory_type_build_cost(state, n, m, type);
-				float output = economy::factory_type_output_cost(state, n, m, type);
-				float input = economy::factory_type_input_cost(state, n, m, type);
+	for(auto type : state.world.in_factory_type) {
+		if(n.get_active_building(type) || type.get_is_available_from_start()) {
+			auto score = economy::score_factory_type(state, n, mid, type, use_cached_scores);
 
-				auto profit = (output - input) * (1.0f - rich_effect);
-				auto roi = profit / cost;
+			auto profit = (score.output_cost - score.input_cost) * (1.0f - rich_effect);
+			auto roi = profit / score.build_cost;
 
-				if(profit / input > 10.f && roi > 0.01f)
-					desired_types.push_back(type.id);
-			} // END if building unlocked
-		}
+			if(profit / score.input_cost > 10.f && roi > 0.01f)
+				desired_types.push_back(type.id);
+		} // END if building unlocked
 	}
 }
 
-void get_desired_factory_types(sys::state& state, dcon::nation_id nid, dcon::market_id mid, std::vector<dcon::factory_type_id>& desired_types) {
+void get_desired_factory_types(sys::state& state, dcon::nation_id nid, dcon::market_id mid, std::vector<dcon::factory_type_id>& desired_types, bool use_cached_scores) {
 	assert(desired_types.empty());
 	auto n = dcon::fatten(state.world, nid);
-	auto m = dcon::fatten(state.world, mid);
-	auto sid = m.get_zone_from_local_market();
 
 	auto const tax_eff = nations::tax_efficiency(state, n);
 	auto const rich_effect = (1.0f - tax_eff * float(state.world.nation_get_rich_tax(n)) / 100.0f);
 
+	// every pass looks at the same scores
+	static thread_local std::vector<std::pair<dcon::factory_type_id, economy::factory_type_score>> unlocked;
+	unlocked.clear();
+	for(auto type : state.world.in_factory_type) {
+		if(n.get_active_building(type) || type.get_is_available_from_start())
+			unlocked.emplace_back(type.id, economy::score_factory_type(state, n, mid, type, use_cached_scores));
+	}
+
 	// pass zero:
 	// factories with stupid income margins
 	// which are impossible to ignore if you are sane
-	if(desired_types.empty()) {
-		for(auto type : state.world.in_factory_type) {
-			if(n.get_active_building(type) || type.get_is_available_from_start()) {
-				auto& inputs = type.get_inputs();
-				bool lacking_input = false;
-				bool lacking_output = m.get_demand_satisfaction(type.get_output()) < 0.98f;
-
-				for(uint32_t i = 0; i < economy::commodity_set::set_size; ++i) {
-					if(inputs.commodity_type[i]) {
-						if(m.get_demand_satisfaction(inputs.commodity_type[i]) < 0.5f)
-							lacking_input = true;
-					} else {
-						break;
-					}
-				}
+	for(auto& [type, score] : unlocked) {
+		float cost = score.build_cost + 0.1f;
+		float input = score.input_cost + 0.1f;
 
-				auto& constr_cost = type.get_construction_costs();
-				auto lacking_constr = false;
+		auto profit = (score.output_cost - input) * (1.0f - rich_effect);
+		auto roi = profit / cost;
 
-				for(uint32_t i = 0; i < economy::commodity_set::set_size; ++i) {
-					if(constr_cost.commodity_type[i]) {
-						if(m.get_demand_satisfaction(constr_cost.commodity_type[i]) < 0.1f)
-							lacking_constr = true;
-					} else {
-						break;
-					}
-				}
-
-				float cost = economy::factory_type_build_cost(state, n, m, type) + 0.1f;
-				float output = economy::factory_type_output_cost(state, n, m, type);
-				float input = economy::factory_type_input_cost(state, n, m, type) + 0.1f;
-
-				auto profit = (output - input) * (1.0f - rich_effect);
-				auto roi = profit / cost;
-
-				if(!lacking_constr && profit / input > 2.f && roi > 0.01f)
-					desired_types.push_back(type.id);
-			} // END if building unlocked
-		}
+		if(!score.lacking_construction && profit / input > 2.f && roi > 0.01f)
+			desired_types.push_back(type);
 	}
 
 	// first pass: try to create factories which will pay back investment fast - in a year at most:
 	// or have very high margins
-	if(desired_types.empty()) { 
-		for(auto type : state.world.in_factory_type) {
-			if(n.get_active_building(type) || type.get_is_available_from_start()) {
-				auto& inputs = type.get_inputs();
-				bool lacking_input = false;
-				bool lacking_output = m.get_demand_satisfaction(type.get_output()) < 0.98f;
-
-				for(uint32_t i = 0; i < economy::commodity_set::set_size; ++i) {
-					if(inputs.commodity_type[i]) {
-						if(m.get_demand_satisfaction(inputs.commodity_type[i]) < 0.5f)
-							lacking_input = true;
-					} else {
-						break;
-					}
-				}
-
-				auto& constr_cost = type.get_construction_costs();
-				auto lacking_constr = false;
-
-				for(uint32_t i = 0; i < economy::commodity_set::set_size; ++i) {
-					if(constr_cost.commodity_type[i]) {
-						if(m.get_demand_satisfaction(constr_cost.commodity_type[i]) < 0.1f)
-							lacking_constr = true;
-					} else {
-						break;
-					}
-				}
-
-				float cost = economy::factory_type_build_cost(state, n, m, type) + 0.1f;
-				float output = economy::factory_type_output_cost(state, n, m, type);
-				float input = economy::factory_type_input_cost(state, n, m, type) + 0.1f;
-				auto profit = (output - input) * (1.0f - rich_effect);
-				auto roi = profit / cost;
+	if(desired_types.empty()) {
+		for(auto& [type, score] : unlocked) {
+			float cost = score.build_cost + 0.1f;
+			float input = score.input_cost + 0.1f;
+			auto profit = (score.output_cost - input) * (1.0f - rich_effect);
 
-				if((!lacking_input && !lacking_constr && (lacking_output || (profit / cost > 0.005f))) || profit / input > 1.00f)
-					desired_types.push_back(type.id);
-			} // END if building unlocked
+			if((!score.lacking_input && !score.lacking_construction && (score.lacking_output || (profit / cost > 0.005f))) || profit / input > 1.00f)
+				desired_types.push_back(type);
 		}
 	}
 
 	// second pass: try to create factories which have a good profit margin
 	if(desired_types.empty()) {
-		for(auto type : state.world.in_factory_type) {
-			if(n.get_active_building(type) || type.get_is_available_from_start()) {
-				auto& inputs = type.get_inputs();
-				bool lacking_input = false;
-				bool lacking_output = m.get_demand_satisfaction(type.get_output()) < 0.98f;
-
-				for(uint32_t i = 0; i < economy::commodity_set::set_size; ++i) {
-					if(inputs.commodity_type[i]) {
-						if(m.get_demand_satisfaction(inputs.commodity_type[i]) < 0.5f)
-							lacking_input = true;
-					} else {
-						break;
-					}
-				}
-
-				auto& constr_cost = type.get_construction_costs();
-				auto lacking_constr = false;
+		for(auto& [type, score] : unlocked) {
+			float cost = score.build_cost + 0.1f;
+			float input = score.input_cost + 0.1f;
+			auto profit = (score.output_cost - input) * (1.0f - rich_effect);
+			auto roi = profit / cost;
 
-				for(uint32_t i = 0; i < economy::commodity_set::set_size; ++i) {
-					if(constr_cost.commodity_type[i]) {
-						if(m.get_demand_satisfaction(constr_cost.commodity_type[i]) < 0.1f)
-							lacking_constr = true;
-					} else {
-						break;
-					}
-				}
-
-				float cost = economy::factory_type_build_cost(state, n, m, type) + 0.1f;
-				float output = economy::factory_type_output_cost(state, n, m, type);
-				float input = economy::factory_type_input_cost(state, n, m, type) + 0.1f;
-				auto profit = (output - input) * (1.0f - rich_effect);
-				auto roi = profit / cost;
-
-				if(!lacking_input && !lacking_constr && profit / input > 0.3f && roi > 0.001f)
-					desired_types.push_back(type.id);
-			} // END if building unlocked
+			if(!score.lacking_input && !score.lacking_construction && profit / input > 0.3f && roi > 0.001f)
+				desired_types.push_back(type);
 		}
 	}
 }
@@ -1290,84 +1204,48 @@ void get_desired_factory_types(sys::state& state, dcon::nation_id nid, dcon::mar
 void get_state_craved_factory_types(sys::state& state, dcon::nation_id nid, dcon::market_id mid, std::vector<dcon::factory_type_id>& desired_types) {
 	assert(desired_types.empty());
 	auto n = dcon::fatten(state.world, nid);
-	auto m = dcon::fatten(state.world, mid);
-	auto sid = m.get_zone_from_local_market();
-	auto treasury = n.get_stockpiles(economy::money);
 
-	if(desired_types.empty()) {
-		for(auto type : state.world.in_factory_type) {
-			if(n.get_active_building(type) || type.get_is_available_from_start()) {
-
-				float cost = economy::factory_type_build_cost(state, n, m, type) + 0.1f;
-				float output = economy::factory_type_output_cost(state, n, m, type);
-				float input = economy::factory_type_input_cost(state, n, m, type) + 0.1f;
+	for(auto type : state.world.in_factory_type) {
+		if(n.get_active_building(type) || type.get_is_available_from_start()) {
+			auto score = economy::score_factory_type(state, n, mid, type);
+			float input = score.input_cost + 0.1f;
 
-				if((output - input) / input > 20.f)
-					desired_types.push_back(type.id);
-			} // END if building unlocked
-		}
+			if((score.output_cost - input) / input > 20.f)
+				desired_types.push_back(type.id);
+		} // END if building unlocked
 	}
 }
 
 void get_state_desired_factory_types(sys::state& state, dcon::nation_id nid, dcon::market_id mid, std::vector<dcon::factory_type_id>& desired_types) {
 	assert(desired_types.empty());
 	auto n = dcon::fatten(state.world, nid);
-	auto m = dcon::fatten(state.world, mid);
-	auto sid = m.get_zone_from_local_market();
 	auto treasury = n.get_stockpiles(economy::money);
 
-	// first pass: try to create factories which will pay back investment fast - in a year at most:
-	if(desired_types.empty()) {
-		for(auto type : state.world.in_factory_type) {
-			if(n.get_active_building(type) || type.get_is_available_from_start()) {
-				auto& inputs = type.get_inputs();
-				bool lacking_input = false;
-				bool lacking_output = m.get_demand_satisfaction(type.get_output()) < 0.98f;
-
-				for(uint32_t i = 0; i < economy::commodity_set::set_size; ++i) {
-					if(inputs.commodity_type[i]) {
-						if(m.get_demand_satisfaction(inputs.commodity_type[i]) < 0.5f)
-							lacking_input = true;
-					} else {
-						break;
-					}
-				}
+	static thread_local std::vector<std::pair<dcon::factory_type_id, economy::factory_type_score>> unlocked;
+	unlocked.clear();
+	for(auto type : state.world.in_factory_type) {
+		if(n.get_active_building(type) || type.get_is_available_from_start())
+			unlocked.emplace_back(type.id, economy::score_factory_type(state, n, mid, type));
+	}
 
-				float cost = economy::factory_type_build_cost(state, n, m, type) + 0.1f;
-				float output = economy::factory_type_output_cost(state, n, m, type);
-				float input = economy::factory_type_input_cost(state, n, m, type) + 0.1f;
+	// first pass: try to create factories which will pay back investment fast - in a year at most:
+	for(auto& [type, score] : unlocked) {
+		float cost = score.build_cost + 0.1f;
+		float input = score.input_cost + 0.1f;
 
-				if((lacking_output || ((output - input) / cost < 365.f)))
-					desired_types.push_back(type.id);
-			} // END if building unlocked
-		}
+		if((score.lacking_output || ((score.output_cost - input) / cost < 365.f)))
+			desired_types.push_back(type);
 	}
 
 	// second pass: try to create factories which have a good profit margin
 	if(desired_types.empty()) {
-		for(auto type : state.world.in_factory_type) {
-			if(n.get_active_building(type) || type.get_is_available_from_start()) {
-				auto& inputs = type.get_inputs();
-				bool lacking_input = false;
-				bool lacking_output = m.get_demand_satisfaction(type.get_output()) < 0.98f;
-
-				for(uint32_t i = 0; i < economy::commodity_set::set_size; ++i) {
-					if(inputs.commodity_type[i]) {
-						if(m.get_demand_satisfaction(inputs.commodity_type[i]) < 0.5f)
-							lacking_input = true;
-					} else {
-						break;
-					}
-				}
+		for(auto& [type, score] : unlocked) {
+			float cost = score.build_cost + 0.1f;
+			float input = score.input_cost + 0.1f;
+			auto profitabilitymark = std::max(0.01f, cost * 10.f / treasury);
 
-				float cost = economy::factory_type_build_cost(state, n, m, type) + 0.1f;
-				float output = economy::factory_type_output_cost(state, n, m, type);
-				float input = economy::factory_type_input_cost(state, n, m, type) + 0.1f;
-				auto profitabilitymark = std::max(0.01f, cost * 10.f / treasury);
-
-				if((lacking_output || ((output - input) / input > profitabilitymark)))
-					desired_types.push_back(type.id);
-			} // END if building unlocked
+			if((score.lacking_output || ((score.output_cost - input) / input > profitabilitymark)))
+				desired_types.push_back(type);
 		}
 	}
 }
@@ -1449,8 +1327,12 @@ int16_t calculate_desired_army_size(sys::state& state, dcon::nation_id nation) {
 	return int16_t(std::clamp(total * double(factor), 0.1 * fid.get_recruitable_regiments(), 1.0 * fid.get_recruitable_regiments()));
 }
 
-void update_ai_econ_construction(sys::state& state) {
-	for(auto n : state.world.in_nation) {
+void update_ai_econ_construction(sys::state& state, uint32_t first_nation, uint32_t last_nation) {
+	for(uint32_t i = first_nation; i < last_nation; ++i) {
+		dcon::nation_id nid{ dcon::nation_id::value_base_t(i) };
+		if(!state.world.nation_is_valid(nid))
+			continue;
+		auto n = fatten(state.world, nid);
 		// skip over: non ais, dead nations, and nations that aren't making money
 		if(n.get_owned_province_count() == 0 || !n.get_is_civilized())
 			continue;
@@ -4223,8 +4105,12 @@ void update_ships(sys::state& state) {
 	}
 }
 
-void build_ships(sys::state& state) {
-	for(auto n : state.world.in_nation) {
+void build_ships(sys::state& state, uint32_t first_nation, uint32_t last_nation) {
+	for(uint32_t i = first_nation; i < last_nation; ++i) {
+		dcon::nation_id nid{ dcon::nation_id::value_base_t(i) };
+		if(!state.world.nation_is_valid(nid))
+			continue;
+		auto n = fatten(state.world, nid);
 		if(!n.get_is_player_controlled() && n.get_province_naval_construction().begin() == n.get_province_naval_construction().end()) {
 			auto disarm = n.get_disarmed_until();
 			if(disarm && state.current_date < disarm)
@@ -5588,6 +5474,9 @@ void assign_targets(sys::state& state, dcon::nation_id n) {
 }
 
 void make_attacks(sys::state& state) {
+	static auto const phase = profiler::register_phase("ai::make_attacks");
+	profiler::scope ps{ phase };
+
 	concurrency::parallel_for(uint32_t(0), state.world.nation_size(), [&](uint32_t i) {
 		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
 		if(state.world.nation_is_valid(n)) {
@@ -5864,8 +5753,12 @@ bool will_upgrade_regiments(sys::state& state, dcon::nation_id n) {
 	return true;
 }
 
-void update_land_constructions(sys::state& state) {
-	for(auto n : state.world.in_nation) {
+void update_land_constructions(sys::state& state, uint32_t first_nation, uint32_t last_nation) {
+	for(uint32_t i = first_nation; i < last_nation; ++i) {
+		dcon::nation_id nid{ dcon::nation_id::value_base_t(i) };
+		if(!state.world.nation_is_valid(nid))
+			continue;
+		auto n = fatten(state.world, nid);
 		if(n.get_is_player_controlled() || n.get_owned_province_count() == 0)
 			continue;
 		auto disarm = n.get_disarmed_until();
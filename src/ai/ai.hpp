@@ -22,9 +22,9 @@ void update_focuses(sys::state& state);
 void identify_focuses(sys::state& state);
 void take_ai_decisions(sys::state& state);
 void update_ai_ruling_party(sys::state& state);
-void get_craved_factory_types(sys::state& state, dcon::nation_id nid, dcon::market_id mid, std::vector<dcon::factory_type_id>& desired_types);
-void get_desired_factory_types(sys::state& state, dcon::nation_id nid, dcon::market_id mid, std::vector<dcon::factory_type_id>& desired_types);
-void update_ai_econ_construction(sys::state& state);
+void get_craved_factory_types(sys::state& state, dcon::nation_id nid, dcon::market_id mid, std::vector<dcon::factory_type_id>& desired_types, bool use_cached_scores = true);
+void get_desired_factory_types(sys::state& state, dcon::nation_id nid, dcon::market_id mid, std::vector<dcon::factory_type_id>& desired_types, bool use_cached_scores = true);
+void update_ai_econ_construction(sys::state& state, uint32_t first_nation, uint32_t last_nation);
 void update_ai_colonial_investment(sys::state& state);
 void update_ai_colony_starting(sys::state& state);
 void upgrade_colonies(sys::state& state);
@@ -47,11 +47,11 @@ void make_war_decs(sys::state& state);
 void update_budget(sys::state& state);
 void remove_ai_data(sys::state& state, dcon::nation_id n);
 void update_ships(sys::state& state);
-void build_ships(sys::state& state);
+void build_ships(sys::state& state, uint32_t first_nation, uint32_t last_nation);
 void refresh_home_ports(sys::state& state);
 void daily_cleanup(sys::state& state);
 void move_idle_guards(sys::state& state);
-void update_land_constructions(sys::state& state);
+void update_land_constructions(sys::state& state, uint32_t first_nation, uint32_t last_nation);
 void update_naval_transport(sys::state& state);
 void move_gathered_attackers(sys::state& state);
 void gather_to_battle(sys::state& state, dcon::nation_id n, dcon::province_id p);
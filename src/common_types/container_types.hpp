@@ -232,6 +232,47 @@ public:
 	}
 };
 
+// ids of objects whose derived values need to be recomputed
+// marking is constant time, and the ids are visited in the order that they were first marked
+template<typename tag_type>
+class dirty_set {
+private:
+	std::vector<tag_type> members;
+	std::vector<bool> is_member;
+
+public:
+	void mark(tag_type t) {
+		if(!t)
+			return;
+		if(size_t(t.index()) >= is_member.size())
+			is_member.resize(size_t(t.index()) + 1, false);
+		if(!is_member[t.index()]) {
+			is_member[t.index()] = true;
+			members.push_back(t);
+		}
+	}
+	bool contains(tag_type t) const {
+		return t && size_t(t.index()) < is_member.size() && is_member[t.index()];
+	}
+	bool empty() const {
+		return members.empty();
+	}
+	auto size() const {
+		return members.size();
+	}
+	auto begin() const {
+		return members.begin();
+	}
+	auto end() const {
+		return members.end();
+	}
+	void clear() {
+		for(auto t : members)
+			is_member[t.index()] = false;
+		members.clear();
+	}
+};
+
 namespace economy {
 
 struct commodity_set {
@@ -280,6 +321,16 @@ struct checksum_key {
 	const char* to_char() noexcept {
 		return reinterpret_cast<const char*>(&key[0]);
 	}
+	std::string to_hex_string() const noexcept {
+		constexpr char digits[] = "0123456789abcdef";
+		std::string result;
+		result.reserve(key_size * 2);
+		for(uint32_t i = 0; i < key_size; i++) {
+			result += digits[key[i] >> 4];
+			result += digits[key[i] & 0x0F];
+		}
+		return result;
+	}
 };
 static_assert(sizeof(checksum_key) == sizeof(checksum_key::key));
 
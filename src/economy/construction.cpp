@@ -857,6 +857,8 @@ construction_spending_explanation explain_construction_spending_now(sys::state&
 }
 
 float estimate_construction_spending(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->construction_spending;
 	auto treasury = state.world.nation_get_stockpiles(n, economy::money);
 	auto priority = float(state.world.nation_get_construction_spending(n)) / 100.f;
 	auto current_budget = std::max(0.f, treasury * priority);
@@ -864,6 +866,8 @@ float estimate_construction_spending(sys::state& state, dcon::nation_id n) {
 }
 
 float estimate_private_construction_spendings(sys::state& state, dcon::nation_id nid) {
+	if(auto p = cached_budget_projection(state, nid))
+		return p->private_construction_spending;
 	float total = 0.f;
 
 	for(auto c : state.world.nation_get_province_building_construction(nid)) {
@@ -185,58 +185,204 @@ uint32_t common_size(sys::state const& state) {
 	return count_special_keys + uint32_t(2) * state.world.pop_type_size();
 }
 
-template<typename F>
-void sum_over_demographics(sys::state& state, dcon::demographics_key key, F const& source) {
-	// clear province
-	province::ve_for_each_land_province(state, [&](auto pi) { state.world.province_set_demographics(pi, key, ve::fp_vector()); });
-	// sum in province
-	state.world.for_each_pop([&](dcon::pop_id p) {
-		auto location = state.world.pop_get_province_from_pop_location(p);
-		state.world.province_get_demographics(location, key) += source(state, p);
-	});
-	// clear state
-	state.world.execute_serial_over_state_instance(
-			[&](auto si) { state.world.state_instance_set_demographics(si, key, ve::fp_vector()); });
-	// sum in state
-	province::for_each_land_province(state, [&](dcon::province_id p) {
-		auto location = state.world.province_get_state_membership(p);
-		state.world.state_instance_get_demographics(location, key) += state.world.province_get_demographics(p, key);
-	});
-	// clear nation
-	state.world.execute_serial_over_nation([&](auto ni) { state.world.nation_set_demographics(ni, key, ve::fp_vector()); });
-	// sum in nation
-	state.world.for_each_state_instance([&](dcon::state_instance_id s) {
-		auto location = state.world.state_instance_get_nation_from_state_ownership(s);
-		state.world.nation_get_demographics(location, key) += state.world.state_instance_get_demographics(s, key);
-	});
+inline constexpr double demographics_fixed_point_scale = 65536.0;
+
+int64_t to_demographics_fixed_point(double v) {
+	return int64_t(std::llround(v * demographics_fixed_point_scale));
+}
+float from_demographics_fixed_point(int64_t v) {
+	return float(double(v) / demographics_fixed_point_scale);
 }
 
-template<typename F>
-void alt_sum_over_demographics(sys::state& state, dcon::demographics_key key, F const& source) {
-	// clear province
-	province::ve_for_each_land_province(state, [&](auto pi) { state.world.province_set_demographics_alt(pi, key, ve::fp_vector()); });
-	// sum in province
-	state.world.for_each_pop([&](dcon::pop_id p) {
+void update_pop_province_index(sys::state& state) {
+	auto& index = state.pops_by_province;
+	auto const province_count = state.world.province_size();
+	auto const pop_count = state.world.pop_size();
+
+	// counting sort: the pops of each province stay in storage order
+	index.province_start.assign(province_count + 1, 0);
+	for(uint32_t i = 0; i < pop_count; ++i) {
+		auto location = state.world.pop_get_province_from_pop_location(dcon::pop_id{ dcon::pop_id::value_base_t(i) });
+		if(location)
+			++index.province_start[location.index() + 1];
+	}
+	for(uint32_t i = 0; i < province_count; ++i)
+		index.province_start[i + 1] += index.province_start[i];
+	index.pops.resize(index.province_start[province_count]);
+	std::vector<uint32_t> next(index.province_start.begin(), index.province_start.end() - 1);
+	for(uint32_t i = 0; i < pop_count; ++i) {
+		dcon::pop_id p{ dcon::pop_id::value_base_t(i) };
 		auto location = state.world.pop_get_province_from_pop_location(p);
-		state.world.province_get_demographics_alt(location, key) += source(state, p);
-	});
-	// clear state
-	state.world.execute_serial_over_state_instance(
-			[&](auto si) { state.world.state_instance_set_demographics_alt(si, key, ve::fp_vector()); });
-	// sum in state
-	province::for_each_land_province(state, [&](dcon::province_id p) {
-		auto location = state.world.province_get_state_membership(p);
-		state.world.state_instance_get_demographics_alt(location, key) += state.world.province_get_demographics_alt(p, key);
+		if(location)
+			index.pops[next[location.index()]++] = p;
+	}
+}
+
+inline constexpr uint32_t demographics_key_block = 64; // keys rolled up by one task
+
+// Each province for which include(index) holds is summed by one task in its own accumulator: for each of its pops,
+// source(state, p, sums) adds what the pop contributes to the k-th key into sums[k]. The result is stored as the row of
+// fixed point integers province_sums[province * count] up to province_sums[province * count + count].
+template<typename F, typename G>
+void sum_province_rows(sys::state& state, uint32_t count, int64_t* province_sums, G const& include, F const& source) {
+	auto const& index = state.pops_by_province;
+	concurrency::parallel_for(uint32_t(0), state.world.province_size(), [&](uint32_t i) {
+		if(!include(i))
+			return;
+		static thread_local std::vector<double> sums;
+		sums.assign(count, 0.0);
+		for(uint32_t j = index.province_start[i]; j < index.province_start[i + 1]; ++j)
+			source(state, index.pops[j], sums.data());
+		auto row = province_sums + size_t(i) * count;
+		for(uint32_t k = 0; k < count; ++k)
+			row[k] = to_demographics_fixed_point(sums[k]);
 	});
-	// clear nation
-	state.world.execute_serial_over_nation([&](auto ni) { state.world.nation_set_demographics_alt(ni, key, ve::fp_vector()); });
-	// sum in nation
-	state.world.for_each_state_instance([&](dcon::state_instance_id s) {
-		auto location = state.world.state_instance_get_nation_from_state_ownership(s);
-		state.world.nation_get_demographics_alt(location, key) += state.world.state_instance_get_demographics_alt(s, key);
+}
+
+// Adds the province rows up into states and nations, a block of keys per task, and stores the keys first up to
+// first + count of every state and nation, and of the provinces for which write_province(index) holds. Since integer
+// addition doesn't care about order, every machine still gets exactly the same totals, which multiplayer needs.
+template<bool alt = false, typename G>
+void roll_up_demographics(sys::state& state, uint32_t first, uint32_t count, int64_t const* province_sums, G const& write_province) {
+	auto const state_count = state.world.state_instance_size();
+	auto const nation_count = state.world.nation_size();
+	std::vector<int64_t> state_sums(size_t(state_count) * count, 0);
+	std::vector<int64_t> nation_sums(size_t(nation_count) * count, 0);
+	auto const block_count = (count + demographics_key_block - 1) / demographics_key_block;
+	concurrency::parallel_for(uint32_t(0), block_count, [&](uint32_t block) {
+		auto const block_first = block * demographics_key_block;
+		auto const block_last = std::min(block_first + demographics_key_block, count);
+
+		// sum in state
+		province::for_each_land_province(state, [&](dcon::province_id p) {
+			auto location = state.world.province_get_state_membership(p);
+			if(!location)
+				return;
+			auto from = province_sums + size_t(p.index()) * count;
+			auto to = state_sums.data() + size_t(location.index()) * count;
+			for(uint32_t k = block_first; k < block_last; ++k)
+				to[k] += from[k];
+		});
+		// sum in nation
+		state.world.for_each_state_instance([&](dcon::state_instance_id s) {
+			auto location = state.world.state_instance_get_nation_from_state_ownership(s);
+			if(!location)
+				return;
+			auto from = state_sums.data() + size_t(s.index()) * count;
+			auto to = nation_sums.data() + size_t(location.index()) * count;
+			for(uint32_t k = block_first; k < block_last; ++k)
+				to[k] += from[k];
+		});
+
+		for(uint32_t k = block_first; k < block_last; ++k) {
+			dcon::demographics_key key{ dcon::demographics_key::value_base_t(first + k) };
+			province::for_each_land_province(state, [&](dcon::province_id p) {
+				if(!write_province(uint32_t(p.index())))
+					return;
+				auto v = from_demographics_fixed_point(province_sums[size_t(p.index()) * count + k]);
+				if constexpr(alt)
+					state.world.province_set_demographics_alt(p, key, v);
+				else
+					state.world.province_set_demographics(p, key, v);
+			});
+			state.world.for_each_state_instance([&](dcon::state_instance_id s) {
+				auto v = from_demographics_fixed_point(state_sums[size_t(s.index()) * count + k]);
+				if constexpr(alt)
+					state.world.state_instance_set_demographics_alt(s, key, v);
+				else
+					state.world.state_instance_set_demographics(s, key, v);
+			});
+			state.world.for_each_nation([&](dcon::nation_id n) {
+				auto v = from_demographics_fixed_point(nation_sums[size_t(n.index()) * count + k]);
+				if constexpr(alt)
+					state.world.nation_set_demographics_alt(n, key, v);
+				else
+					state.world.nation_set_demographics(n, key, v);
+			});
+		}
 	});
 }
 
+// fills the keys first up to first + count (of the _alt values when alt is set) in a single sweep over the pops
+template<bool alt = false, typename F>
+void sum_over_demographics(sys::state& state, uint32_t first, uint32_t count, F const& source) {
+	if(count == 0)
+		return;
+	std::vector<int64_t> province_sums(size_t(state.world.province_size()) * count, 0);
+	sum_province_rows(state, count, province_sums.data(), [](uint32_t) { return true; }, source);
+	roll_up_demographics<alt>(state, first, count, province_sums.data(), [](uint32_t) { return true; });
+}
+
+// what a pop adds to the common keys: the special keys, then pop type, then employment
+static void add_common_demographics(sys::state const& state, dcon::pop_id p, double* sums) {
+	auto const pop_type_count = state.world.pop_type_size();
+	auto size = state.world.pop_get_size(p);
+	auto type = state.world.pop_get_poptype(p);
+	auto strata = uint32_t(state.world.pop_type_get_strata(type));
+	auto pop_militancy = pop_demographics::get_militancy(state, p);
+
+	sums[total.index()] += double(size);
+	sums[employable.index()] += double(state.world.pop_type_get_has_unemployment(type) ? size : 0.0f);
+	sums[employed.index()] += double(pop_demographics::get_employment(state, p));
+	sums[consciousness.index()] += double(pop_demographics::get_consciousness(state, p) * size);
+	sums[militancy.index()] += double(pop_militancy * size);
+	sums[literacy.index()] += double(pop_demographics::get_literacy(state, p) * size);
+	if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
+		auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
+		if(movement) {
+			auto opt = state.world.movement_get_associated_issue_option(movement);
+			auto optpar = state.world.issue_option_get_parent_issue(opt);
+			if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::political))
+				sums[political_reform_desire.index()] += double(size);
+			if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::social))
+				sums[social_reform_desire.index()] += double(size);
+		}
+	}
+	if(strata <= uint32_t(culture::pop_strata::rich)) {
+		sums[poor_militancy.index() + strata] += double(pop_militancy * size);
+		sums[poor_life_needs.index() + strata] += double(pop_demographics::get_life_needs(state, p) * size);
+		sums[poor_everyday_needs.index() + strata] += double(pop_demographics::get_everyday_needs(state, p) * size);
+		sums[poor_luxury_needs.index() + strata] += double(pop_demographics::get_luxury_needs(state, p) * size);
+		sums[poor_total.index() + strata] += double(size);
+	}
+	if(type) {
+		sums[count_special_keys + type.index()] += double(size);
+		sums[count_special_keys + pop_type_count + type.index()] += double(state.world.pop_type_get_has_unemployment(type) ? pop_demographics::get_employment(state, p) : size);
+	}
+}
+
+// what a pop adds to the extra keys (culture, then ideology, then issue option, then religion) counted from the first
+// culture key, for the keys from first up to last only; the key first goes into sums[0]
+static void add_extra_demographics(sys::state const& state, dcon::pop_id p, double* sums, uint32_t first, uint32_t last) {
+	auto const ideology_start = state.world.culture_size();
+	auto const issue_option_start = ideology_start + state.world.ideology_size();
+	auto const religion_start = issue_option_start + state.world.issue_option_size();
+	auto size = state.world.pop_get_size(p);
+
+	auto c = state.world.pop_get_culture(p);
+	if(c && uint32_t(c.index()) >= first && uint32_t(c.index()) < last)
+		sums[c.index() - first] += double(size);
+	for(uint32_t k = std::max(first, ideology_start); k < std::min(last, issue_option_start); ++k) {
+		auto pdemo_key = pop_demographics::to_key(state, dcon::ideology_id{ dcon::ideology_id::value_base_t(k - ideology_start) });
+		sums[k - first] += double(pop_demographics::get_demo(state, p, pdemo_key) * size);
+	}
+	for(uint32_t k = std::max(first, issue_option_start); k < std::min(last, religion_start); ++k) {
+		auto pdemo_key = pop_demographics::to_key(state, dcon::issue_option_id{ dcon::issue_option_id::value_base_t(k - issue_option_start) });
+		sums[k - first] += double(pop_demographics::get_demo(state, p, pdemo_key) * size);
+	}
+	auto r = state.world.pop_get_religion(p);
+	if(r && religion_start + r.index() >= first && religion_start + r.index() < last)
+		sums[religion_start + r.index() - first] += double(size);
+}
+
+void mark_changed(sys::state& state, dcon::province_id p) {
+	auto& changed = state.extra_demographics.changed;
+	if(changed.size() != state.world.province_size())
+		changed.resize(state.world.province_size(), 0);
+	if(p)
+		changed[p.index()] = 1;
+}
+
 void alt_copy_demographics(sys::state& state, dcon::demographics_key key) {
 	province::ve_for_each_land_province(state, [&](auto pi) {
 		state.world.province_set_demographics_alt(pi, key, state.world.province_get_demographics(pi, key));
@@ -283,6 +429,9 @@ void regenerate_jingoism_support(sys::state& state, dcon::nation_id n) {
 			return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
 		});
 	}
+	// so that the next daily update doesn't put back its older totals
+	for(const auto pc : state.world.nation_get_province_control_as_nation(n))
+		mark_changed(state, pc.get_province());
 }
 
 template<bool full>
@@ -290,226 +439,33 @@ void regenerate_from_pop_data(sys::state& state) {
 	auto const sz = size(state);
 	auto const csz = common_size(state);
 	auto const extra_size = sz - csz;
-	auto const extra_group_size = (extra_size + extra_demo_grouping - 1) / extra_demo_grouping;
 
-	concurrency::parallel_for(uint32_t(0), full ?  sz : csz + extra_group_size, [&](uint32_t base_index) {
-		auto index = base_index;
-		if constexpr(!full) {
-			if(index >= csz) {
-				index += extra_group_size * (state.current_date.value % extra_demo_grouping);
-				if(index >= sz)
-					return;
-			}
-		}
-		dcon::demographics_key key{dcon::demographics_key::value_base_t(index)};
-		if(index < count_special_keys) {
-			switch(index) {
-			case 0: // constexpr inline dcon::demographics_key total(0);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) { return state.world.pop_get_size(p); });
-				break;
-			case 1: // constexpr inline dcon::demographics_key employable(1);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_has_unemployment(state.world.pop_get_poptype(p)) ? state.world.pop_get_size(p) : 0.0f;
-				});
-				break;
-			case 2: // constexpr inline dcon::demographics_key employed(2);
-				sum_over_demographics(state, key,
-						[](sys::state const& state, dcon::pop_id p) { return pop_demographics::get_employment(state, p); });
-				break;
-			case 3: // constexpr inline dcon::demographics_key consciousness(3);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_consciousness(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 4: // constexpr inline dcon::demographics_key militancy(4);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 5: // constexpr inline dcon::demographics_key literacy(5);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_literacy(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 6: // constexpr inline dcon::demographics_key political_reform_desire(6);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
-						auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-						if(movement) {
-							auto opt = state.world.movement_get_associated_issue_option(movement);
-							auto optpar = state.world.issue_option_get_parent_issue(opt);
-							if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::political))
-								return state.world.pop_get_size(p);
-						}
-						return 0.0f;
-					} else
-						return 0.0f;
-				});
-				break;
-			case 7: // constexpr inline dcon::demographics_key social_reform_desire(7);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
-						auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-						if(movement) {
-							auto opt = state.world.movement_get_associated_issue_option(movement);
-							auto optpar = state.world.issue_option_get_parent_issue(opt);
-							if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::social))
-								return state.world.pop_get_size(p);
-						}
-						return 0.0f;
-					} else
-						return 0.0f;
-				});
-				break;
-			case 8: // constexpr inline dcon::demographics_key poor_militancy(8);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-										 ? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 9: // constexpr inline dcon::demographics_key middle_militancy(9);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-										 ? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 10: // constexpr inline dcon::demographics_key rich_militancy(10);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-										 ? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 11: // constexpr inline dcon::demographics_key poor_life_needs(11);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-										 ? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 12: // constexpr inline dcon::demographics_key middle_life_needs(12);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-										 ? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 13: // constexpr inline dcon::demographics_key rich_life_needs(13);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-										 ? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 14: // constexpr inline dcon::demographics_key poor_everyday_needs(14);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-										 ? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 15: // constexpr inline dcon::demographics_key middle_everyday_needs(15);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-										 ? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 16: // constexpr inline dcon::demographics_key rich_everyday_needs(16);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-										 ? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 17: // constexpr inline dcon::demographics_key poor_luxury_needs(17);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-										 ? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 18: // constexpr inline dcon::demographics_key middle_luxury_needs(18);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-										 ? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 19: // constexpr inline dcon::demographics_key rich_luxury_needs(19);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-										 ? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 20: // constexpr inline dcon::demographics_key poor_total(20);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-										 ? state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 21: // constexpr inline dcon::demographics_key middle_total(21);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-										 ? state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			case 22: // constexpr inline dcon::demographics_key rich_total(22);
-				sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-										 ? state.world.pop_get_size(p)
-										 : 0.0f;
-				});
-				break;
-			}
-		// common - pop type - employment - culture - ideology - issue option - religion
-		} else if(key.index() < to_employment_key(state, dcon::pop_type_id(0)).index()) { // pop type
-			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys)) };
-			sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_poptype(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		} else if(key.index() < to_key(state, dcon::culture_id(0)).index()) { // employment
-			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys + state.world.pop_type_size())) };
-			if(state.world.pop_type_get_has_unemployment(pkey)) {
-				sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_get_poptype(p) == pkey ? pop_demographics::get_employment(state, p) : 0.0f;
-				});
-			} else {
-				sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_get_poptype(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-				});
-			}
-		} else if(key.index() < to_key(state, dcon::ideology_id(0)).index()) { // culture
-			dcon::culture_id pkey{
-					dcon::culture_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2)) };
-			sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_culture(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		} else if(key.index() < to_key(state, dcon::issue_option_id(0)).index()) { // ideology
-			dcon::ideology_id pkey{dcon::ideology_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size()))};
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
-			});
-		} else if(key.index() < to_key(state, dcon::religion_id(0)).index()) { // issue option
-			dcon::issue_option_id pkey{dcon::issue_option_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size() + state.world.ideology_size()))};
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
-			});
-		} else  { // religion
-			dcon::religion_id pkey{dcon::religion_id::value_base_t(
-					index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size() + state.world.ideology_size() + state.world.issue_option_size()))};
-			sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_religion(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		}
+	update_pop_province_index(state);
+
+	// common - pop type - employment: every day, in one sweep
+	sum_over_demographics(state, 0, csz, add_common_demographics);
+
+	// culture - ideology - issue option - religion: one sweep for all of them. Their province rows are kept from one day to
+	// the next, so a daily update only sums again the provinces that were marked as changed, plus a rotating slice of the
+	// rest to pick up changes that nobody marks (events, casualties and the like)
+	auto const province_count = state.world.province_size();
+	auto& cache = state.extra_demographics;
+	if(cache.changed.size() != province_count)
+		cache.changed.resize(province_count, 0);
+	if(full || !cache.valid || cache.province_sums.size() != size_t(province_count) * extra_size) {
+		cache.province_sums.assign(size_t(province_count) * extra_size, 0);
+		std::fill(cache.changed.begin(), cache.changed.end(), uint8_t(1));
+		cache.valid = true;
+	} else {
+		for(uint32_t i = state.current_date.value % extra_demo_grouping; i < province_count; i += extra_demo_grouping)
+			cache.changed[i] = 1;
+	}
+	auto refresh = [&](uint32_t i) { return cache.changed[i] != 0; };
+	sum_province_rows(state, extra_size, cache.province_sums.data(), refresh, [extra_size](sys::state const& state, dcon::pop_id p, double* sums) {
+		add_extra_demographics(state, p, sums, 0, extra_size);
 	});
+	roll_up_demographics(state, csz, extra_size, cache.province_sums.data(), refresh);
+	std::fill(cache.changed.begin(), cache.changed.end(), uint8_t(0));
 
 	//
 	// calculate values derived from demographics
@@ -864,231 +820,32 @@ void regenerate_from_pop_data_daily(sys::state& state) {
 	regenerate_from_pop_data<false>(state);
 }
 
+// The single player version sums into the _alt values, which are swapped in at the end of the day: every common key, and
+// either every extra key or, day by day, a rotating group of them (the rest are copied over from the other buffer)
 template<bool full>
-void alt_mt_regenerate_from_pop_data(sys::state& state) {
+void alt_sum_demographics(sys::state& state) {
 	auto const sz = size(state);
 	auto const csz = common_size(state);
 	auto const extra_size = sz - csz;
 	auto const extra_group_size = (extra_size + extra_demo_grouping - 1) / extra_demo_grouping;
 
-	concurrency::parallel_for(uint32_t(0), full ? sz : csz + extra_group_size, [&](uint32_t base_index) {
-		auto index = base_index;
-		if constexpr(!full) {
-			if(index >= csz) {
-				index += extra_group_size * (state.current_date.value % extra_demo_grouping);
-				if(index >= sz)
-					return;
-			}
-		}
-		dcon::demographics_key key{ dcon::demographics_key::value_base_t(index) };
-		if(index < count_special_keys) {
-			switch(index) {
-			case 0: // constexpr inline dcon::demographics_key total(0);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) { return state.world.pop_get_size(p); });
-				break;
-			case 1: // constexpr inline dcon::demographics_key employable(1);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_has_unemployment(state.world.pop_get_poptype(p)) ? state.world.pop_get_size(p) : 0.0f;
-				});
-				break;
-			case 2: // constexpr inline dcon::demographics_key employed(2);
-				alt_sum_over_demographics(state, key,
-						[](sys::state const& state, dcon::pop_id p) { return pop_demographics::get_employment(state, p); });
-				break;
-			case 3: // constexpr inline dcon::demographics_key consciousness(3);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_consciousness(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 4: // constexpr inline dcon::demographics_key militancy(4);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 5: // constexpr inline dcon::demographics_key literacy(5);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_literacy(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 6: // constexpr inline dcon::demographics_key political_reform_desire(6);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
-						auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-						if(movement) {
-							auto opt = state.world.movement_get_associated_issue_option(movement);
-							auto optpar = state.world.issue_option_get_parent_issue(opt);
-							if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::political))
-								return state.world.pop_get_size(p);
-						}
-						return 0.0f;
-					} else
-						return 0.0f;
-				});
-				break;
-			case 7: // constexpr inline dcon::demographics_key social_reform_desire(7);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
-						auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-						if(movement) {
-							auto opt = state.world.movement_get_associated_issue_option(movement);
-							auto optpar = state.world.issue_option_get_parent_issue(opt);
-							if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::social))
-								return state.world.pop_get_size(p);
-						}
-						return 0.0f;
-					} else
-						return 0.0f;
-				});
-				break;
-			case 8: // constexpr inline dcon::demographics_key poor_militancy(8);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 9: // constexpr inline dcon::demographics_key middle_militancy(9);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 10: // constexpr inline dcon::demographics_key rich_militancy(10);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 11: // constexpr inline dcon::demographics_key poor_life_needs(11);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 12: // constexpr inline dcon::demographics_key middle_life_needs(12);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 13: // constexpr inline dcon::demographics_key rich_life_needs(13);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 14: // constexpr inline dcon::demographics_key poor_everyday_needs(14);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 15: // constexpr inline dcon::demographics_key middle_everyday_needs(15);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 16: // constexpr inline dcon::demographics_key rich_everyday_needs(16);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 17: // constexpr inline dcon::demographics_key poor_luxury_needs(17);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 18: // constexpr inline dcon::demographics_key middle_luxury_needs(18);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 19: // constexpr inline dcon::demographics_key rich_luxury_needs(19);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 20: // constexpr inline dcon::demographics_key poor_total(20);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 21: // constexpr inline dcon::demographics_key middle_total(21);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 22: // constexpr inline dcon::demographics_key rich_total(22);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			}
-			// common - pop type - employment - culture - ideology - issue option - religion
-		} else if(key.index() < to_employment_key(state, dcon::pop_type_id(0)).index()) { // pop type
-			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys)) };
-			alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_poptype(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		} else if(key.index() < to_key(state, dcon::culture_id(0)).index()) { // employment
-			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys + state.world.pop_type_size())) };
-			if(state.world.pop_type_get_has_unemployment(pkey)) {
-				alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_get_poptype(p) == pkey ? pop_demographics::get_employment(state, p) : 0.0f;
-				});
-			} else {
-				alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_get_poptype(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-				});
-			}
-		} else if(key.index() < to_key(state, dcon::ideology_id(0)).index()) { // culture
-			dcon::culture_id pkey{
-					dcon::culture_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2)) };
-			alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_culture(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		} else if(key.index() < to_key(state, dcon::issue_option_id(0)).index()) { // ideology
-			dcon::ideology_id pkey{ dcon::ideology_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size())) };
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			alt_sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
-			});
-		} else if(key.index() < to_key(state, dcon::religion_id(0)).index()) { // issue option
-			dcon::issue_option_id pkey{ dcon::issue_option_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size() + state.world.ideology_size())) };
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			alt_sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
-			});
-		} else { // religion
-			dcon::religion_id pkey{ dcon::religion_id::value_base_t(
-					index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size() + state.world.ideology_size() + state.world.issue_option_size())) };
-			alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_religion(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		}
+	update_pop_province_index(state);
+	sum_over_demographics<true>(state, 0, csz, add_common_demographics);
+
+	uint32_t first = 0;
+	uint32_t last = extra_size;
+	if constexpr(!full) {
+		first = std::min(extra_group_size * (state.current_date.value % extra_demo_grouping), extra_size);
+		last = std::min(first + extra_group_size, extra_size);
+	}
+	sum_over_demographics<true>(state, csz + first, last - first, [first, last](sys::state const& state, dcon::pop_id p, double* sums) {
+		add_extra_demographics(state, p, sums, first, last);
 	});
+}
+
+template<bool full>
+void alt_mt_regenerate_from_pop_data(sys::state& state) {
+	alt_sum_demographics<full>(state);
 
 	//
 	// calculate values derived from demographics
@@ -1364,224 +1121,7 @@ void alt_st_regenerate_from_pop_data(sys::state& state) {
 	auto const extra_size = sz - csz;
 	auto const extra_group_size = (extra_size + extra_demo_grouping - 1) / extra_demo_grouping;
 
-	for(uint32_t base_index = 0; base_index < (full ? sz : csz + extra_group_size); ++ base_index) {
-		auto index = base_index;
-		if constexpr(!full) {
-			if(index >= csz) {
-				index += extra_group_size * (state.current_date.value % extra_demo_grouping);
-				if(index >= sz)
-					break;
-			}
-		}
-		dcon::demographics_key key{ dcon::demographics_key::value_base_t(index) };
-		if(index < count_special_keys) {
-			switch(index) {
-			case 0: // constexpr inline dcon::demographics_key total(0);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) { return state.world.pop_get_size(p); });
-				break;
-			case 1: // constexpr inline dcon::demographics_key employable(1);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_has_unemployment(state.world.pop_get_poptype(p)) ? state.world.pop_get_size(p) : 0.0f;
-				});
-				break;
-			case 2: // constexpr inline dcon::demographics_key employed(2);
-				alt_sum_over_demographics(state, key,
-						[](sys::state const& state, dcon::pop_id p) { return pop_demographics::get_employment(state, p); });
-				break;
-			case 3: // constexpr inline dcon::demographics_key consciousness(3);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_consciousness(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 4: // constexpr inline dcon::demographics_key militancy(4);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 5: // constexpr inline dcon::demographics_key literacy(5);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return pop_demographics::get_literacy(state, p) * state.world.pop_get_size(p);
-				});
-				break;
-			case 6: // constexpr inline dcon::demographics_key political_reform_desire(6);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
-						auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-						if(movement) {
-							auto opt = state.world.movement_get_associated_issue_option(movement);
-							auto optpar = state.world.issue_option_get_parent_issue(opt);
-							if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::political))
-								return state.world.pop_get_size(p);
-						}
-						return 0.0f;
-					} else
-						return 0.0f;
-				});
-				break;
-			case 7: // constexpr inline dcon::demographics_key social_reform_desire(7);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					if(state.world.province_get_is_colonial(state.world.pop_get_province_from_pop_location(p)) == false) {
-						auto movement = state.world.pop_get_movement_from_pop_movement_membership(p);
-						if(movement) {
-							auto opt = state.world.movement_get_associated_issue_option(movement);
-							auto optpar = state.world.issue_option_get_parent_issue(opt);
-							if(opt && state.world.issue_get_issue_type(optpar) == uint8_t(culture::issue_type::social))
-								return state.world.pop_get_size(p);
-						}
-						return 0.0f;
-					} else
-						return 0.0f;
-				});
-				break;
-			case 8: // constexpr inline dcon::demographics_key poor_militancy(8);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 9: // constexpr inline dcon::demographics_key middle_militancy(9);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 10: // constexpr inline dcon::demographics_key rich_militancy(10);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_militancy(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 11: // constexpr inline dcon::demographics_key poor_life_needs(11);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 12: // constexpr inline dcon::demographics_key middle_life_needs(12);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 13: // constexpr inline dcon::demographics_key rich_life_needs(13);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_life_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 14: // constexpr inline dcon::demographics_key poor_everyday_needs(14);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 15: // constexpr inline dcon::demographics_key middle_everyday_needs(15);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 16: // constexpr inline dcon::demographics_key rich_everyday_needs(16);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_everyday_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 17: // constexpr inline dcon::demographics_key poor_luxury_needs(17);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 18: // constexpr inline dcon::demographics_key middle_luxury_needs(18);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 19: // constexpr inline dcon::demographics_key rich_luxury_needs(19);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? pop_demographics::get_luxury_needs(state, p) * state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 20: // constexpr inline dcon::demographics_key poor_total(20);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::poor)
-						? state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 21: // constexpr inline dcon::demographics_key middle_total(21);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::middle)
-						? state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			case 22: // constexpr inline dcon::demographics_key rich_total(22);
-				alt_sum_over_demographics(state, key, [](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_type_get_strata(state.world.pop_get_poptype(p)) == uint8_t(culture::pop_strata::rich)
-						? state.world.pop_get_size(p)
-						: 0.0f;
-				});
-				break;
-			}
-			// common - pop type - employment - culture - ideology - issue option - religion
-		} else if(key.index() < to_employment_key(state, dcon::pop_type_id(0)).index()) { // pop type
-			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys)) };
-			alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_poptype(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		} else if(key.index() < to_key(state, dcon::culture_id(0)).index()) { // employment
-			dcon::pop_type_id pkey{ dcon::pop_type_id::value_base_t(index - (count_special_keys + state.world.pop_type_size())) };
-			if(state.world.pop_type_get_has_unemployment(pkey)) {
-				alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_get_poptype(p) == pkey ? pop_demographics::get_employment(state, p) : 0.0f;
-				});
-			} else {
-				alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-					return state.world.pop_get_poptype(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-				});
-			}
-		} else if(key.index() < to_key(state, dcon::ideology_id(0)).index()) { // culture
-			dcon::culture_id pkey{
-					dcon::culture_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2)) };
-			alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_culture(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		} else if(key.index() < to_key(state, dcon::issue_option_id(0)).index()) { // ideology
-			dcon::ideology_id pkey{ dcon::ideology_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size())) };
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			alt_sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
-			});
-		} else if(key.index() < to_key(state, dcon::religion_id(0)).index()) { // issue option
-			dcon::issue_option_id pkey{ dcon::issue_option_id::value_base_t(index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size() + state.world.ideology_size())) };
-			auto pdemo_key = pop_demographics::to_key(state, pkey);
-			alt_sum_over_demographics(state, key, [pdemo_key](sys::state const& state, dcon::pop_id p) {
-				return pop_demographics::get_demo(state, p, pdemo_key) * state.world.pop_get_size(p);
-			});
-		} else { // religion
-			dcon::religion_id pkey{ dcon::religion_id::value_base_t(
-					index - (count_special_keys + state.world.pop_type_size() * 2 + state.world.culture_size() + state.world.ideology_size() + state.world.issue_option_size())) };
-			alt_sum_over_demographics(state, key, [pkey](sys::state const& state, dcon::pop_id p) {
-				return state.world.pop_get_religion(p) == pkey ? state.world.pop_get_size(p) : 0.0f;
-			});
-		}
-	}
+	alt_sum_demographics<full>(state);
 
 	if constexpr(full == false) { // copies
 		for(uint32_t base_index = csz; base_index < (full ? sz : csz + extra_group_size); ++base_index) {
@@ -1949,6 +1489,16 @@ void execute_staggered_blocks(uint32_t offset, uint32_t divisions, uint32_t max,
 	}
 }
 
+void mark_changed_pops(sys::state& state, uint32_t offset, uint32_t divisions) {
+	auto const pop_count = state.world.pop_size();
+	execute_staggered_blocks(offset, divisions, pop_count, [&](auto ids) {
+		ve::apply([&](dcon::pop_id p) {
+			if(uint32_t(p.index()) < pop_count)
+				mark_changed(state, state.world.pop_get_province_from_pop_location(p));
+		}, ids);
+	});
+}
+
 template<typename F>
 void pexecute_staggered_blocks(uint32_t offset, uint32_t divisions, uint32_t max, F&& functor) {
 	concurrency::parallel_for(16 * offset, max, 16 * divisions, [&](uint32_t index) {
@@ -3252,6 +2802,46 @@ float get_estimated_assimilation(sys::state& state, dcon::pop_id ids) {
 }
 
 namespace impl {
+// how much a province attracts pop p of type pt, for internal and colonial migration
+float province_migration_weight(sys::state& state, dcon::pop_type_id pt, dcon::province_id prov, dcon::pop_id p) {
+	auto modifier = state.world.pop_type_get_migration_target(pt);
+	auto modifier_fn = state.world.pop_type_get_migration_target_fn(pt);
+	auto attract = state.world.province_get_modifier_values(prov, sys::provincial_mod_offsets::immigrant_attract) + 1.0f;
+	if(modifier_fn) {
+		using ftype = float(*)(int32_t, int32_t);
+		ftype fn = (ftype)modifier_fn;
+		float llvm_result = fn(prov.index(), p.index());
+#ifdef CHECK_LLVM_RESULTS
+		float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(prov), trigger::to_generic(p), 0);
+		assert(llvm_result == interp_result);
+#endif
+		return std::max(0.0f, llvm_result * attract);
+	} else {
+		float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(prov), trigger::to_generic(p), 0);
+		return std::max(0.0f, interp_result * attract);
+	}
+}
+
+// how much a nation attracts pop p of type pt, for immigration
+float nation_immigration_weight(sys::state& state, dcon::pop_type_id pt, dcon::nation_id inner, dcon::pop_id p) {
+	auto modifier = state.world.pop_type_get_country_migration_target(pt);
+	auto modifier_fn = state.world.pop_type_get_country_migration_target_fn(pt);
+	auto attract = std::max(0.f, (state.world.nation_get_modifier_values(inner, sys::national_mod_offsets::global_immigrant_attract) + 1.0f));
+	if(modifier_fn) {
+		using ftype = float(*)(int32_t, int32_t);
+		ftype fn = (ftype)modifier_fn;
+		float llvm_result = fn(inner.index(), p.index());
+#ifdef CHECK_LLVM_RESULTS
+		float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(inner), trigger::to_generic(p), 0);
+		assert( llvm_result == interp_result);
+#endif
+		return std::max(0.0f, llvm_result * attract);
+	} else {
+		float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(inner), trigger::to_generic(p), 0);
+		return std::max(0.0f, interp_result * attract);
+	}
+}
+
 dcon::province_id get_province_target_in_nation(sys::state& state, dcon::nation_id n, dcon::pop_id p) {
 	/*
 	Destination for internal migration: colonial provinces are not valid targets, nor are non state capital provinces for pop
@@ -3265,29 +2855,14 @@ dcon::province_id get_province_target_in_nation(sys::state& state, dcon::nation_
 	float total_weight = 0.0f;
 
 	auto pt = state.world.pop_get_poptype(p);
-	auto modifier = state.world.pop_type_get_migration_target(pt);
-	auto modifier_fn = state.world.pop_type_get_migration_target_fn(pt);
-	if(!modifier)
+	if(!state.world.pop_type_get_migration_target(pt))
 		return dcon::province_id{};
 
 	bool limit_to_capitals = state.world.pop_type_get_state_capital_only(pt);
 	for(auto loc : state.world.nation_get_province_ownership(n)) {
 		if(loc.get_province().get_is_colonial() == false) {
 			if(!limit_to_capitals || loc.get_province().get_state_membership().get_capital().id == loc.get_province().id) {
-				float weight = 0.0f;
-				if(modifier_fn) {
-					using ftype = float(*)(int32_t, int32_t);
-					ftype fn = (ftype)modifier_fn;
-					float llvm_result = fn(loc.get_province().id.index(), p.index());
-#ifdef CHECK_LLVM_RESULTS
-					float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(loc.get_province().id), trigger::to_generic(p), 0);
-					assert(llvm_result == interp_result);
-#endif
-					weight = std::max(0.0f, llvm_result * (loc.get_province().get_modifier_values(sys::provincial_mod_offsets::immigrant_attract) + 1.0f));
-				} else {
-					float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(loc.get_province().id), trigger::to_generic(p), 0);
-					weight = std::max(0.0f, interp_result * (loc.get_province().get_modifier_values(sys::provincial_mod_offsets::immigrant_attract) + 1.0f));
-				}
+				float weight = province_migration_weight(state, pt, loc.get_province(), p);
 
 				if(weight > 0.0f) {
 					weights_buffer.set(loc.get_province(), weight);
@@ -3319,34 +2894,20 @@ dcon::province_id get_colonial_province_target_in_nation(sys::state& state, dcon
 	auto weights_buffer = state.world.province_make_vectorizable_float_buffer();
 	float total_weight = 0.0f;
 
-	auto modifier = state.world.pop_type_get_migration_target(state.world.pop_get_poptype(p));
-	auto modifier_fn = state.world.pop_type_get_migration_target_fn(state.world.pop_get_poptype(p));
-	if(!modifier)
+	auto pt = state.world.pop_get_poptype(p);
+	if(!state.world.pop_type_get_migration_target(pt))
 		return dcon::province_id{};
 
 	auto overseas_culture = state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p));
 	auto home_continent = state.world.province_get_continent(state.world.pop_get_province_from_pop_location(p));
 
-	bool limit_to_capitals = state.world.pop_type_get_state_capital_only(state.world.pop_get_poptype(p));
+	bool limit_to_capitals = state.world.pop_type_get_state_capital_only(pt);
 	for(auto loc : state.world.nation_get_province_ownership(n)) {
 		if(loc.get_province().get_is_colonial() == true) {
 			if((overseas_culture || loc.get_province().get_continent() == home_continent) &&
 					(!limit_to_capitals || loc.get_province().get_state_membership().get_capital().id == loc.get_province().id)) {
 
-				float weight = 0.0f;
-				if(modifier_fn) {
-					using ftype = float(*)(int32_t, int32_t);
-					ftype fn = (ftype)modifier_fn;
-					float llvm_result = fn(loc.get_province().id.index(), p.index());
-#ifdef CHECK_LLVM_RESULTS
-					float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(loc.get_province().id), trigger::to_generic(p), 0);
-					assert(llvm_result == interp_result);
-#endif
-					weight = std::max(0.0f, llvm_result * (loc.get_province().get_modifier_values(sys::provincial_mod_offsets::immigrant_attract) + 1.0f));
-				} else {
-					float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(loc.get_province().id), trigger::to_generic(p), 0);
-					weight = std::max(0.0f, interp_result * (loc.get_province().get_modifier_values(sys::provincial_mod_offsets::immigrant_attract) + 1.0f));
-				}
+				float weight = province_migration_weight(state, pt, loc.get_province(), p);
 
 				if(weight > 0.0f) {
 					if(!limit_to_capitals || loc.get_province().get_state_membership().get_capital().id == loc.get_province().id) {
@@ -3372,7 +2933,7 @@ dcon::province_id get_colonial_province_target_in_nation(sys::state& state, dcon
 	return dcon::province_id{};
 }
 
-dcon::nation_id get_immigration_target(sys::state& state, dcon::nation_id owner, dcon::pop_id p, sys::date day) {
+dcon::nation_id get_immigration_target(sys::state& state, dcon::nation_id owner, dcon::pop_id p, sys::date day, migration_buffer const* shared) {
 	/*
 	Country targets for external migration: must be a country with its capital on a different continent from the source country
 	*or* an adjacent country (same continent, but non adjacent, countries are not targets). Each country target is then weighted:
@@ -3385,10 +2946,10 @@ dcon::nation_id get_immigration_target(sys::state& state, dcon::nation_id owner,
 	*/
 
 	auto pt = state.world.pop_get_poptype(p);
-	auto modifier = state.world.pop_type_get_country_migration_target(pt);
-	auto modifier_fn = state.world.pop_type_get_country_migration_target_fn(pt);
-	if(!modifier)
+	if(!state.world.pop_type_get_country_migration_target(pt))
 		return dcon::nation_id{};
+	auto const pop_type_count = state.world.pop_type_size();
+	bool use_shared = shared && shared->shared_nation_weights[pt.index()];
 
 	dcon::nation_id top_nations[3] = {dcon::nation_id{}, dcon::nation_id{}, dcon::nation_id{}};
 	float top_weights[3] = {0.0f, 0.0f, 0.0f};
@@ -3407,20 +2968,9 @@ dcon::nation_id get_immigration_target(sys::state& state, dcon::nation_id owner,
 			return; // ignore same continent, non-adjacent nations
 		}
 
-		float weight = 0.0f;
-		if(modifier_fn) {
-			using ftype = float(*)(int32_t, int32_t);
-			ftype fn = (ftype)modifier_fn;
-			float llvm_result = fn(inner.index(), p.index());
-#ifdef CHECK_LLVM_RESULTS
-			float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(inner), trigger::to_generic(p), 0);
-			assert( llvm_result == interp_result);
-#endif
-			weight = std::max(0.0f, llvm_result * std::max(0.f, (state.world.nation_get_modifier_values(inner, sys::national_mod_offsets::global_immigrant_attract) + 1.0f)));
-		} else {
-			float interp_result = trigger::evaluate_multiplicative_modifier(state, modifier, trigger::to_generic(inner), trigger::to_generic(p), 0);
-			weight = std::max(0.0f, interp_result * std::max(0.f, (state.world.nation_get_modifier_values(inner, sys::national_mod_offsets::global_immigrant_attract) + 1.0f)));
-		}
+		float weight = use_shared
+			? shared->nation_weights[size_t(inner.index()) * pop_type_count + pt.index()]
+			: nation_immigration_weight(state, pt, inner, p);
 
 		if(weight > top_weights[2]) {
 			top_weights[2] = weight;
@@ -3451,10 +3001,141 @@ dcon::nation_id get_immigration_target(sys::state& state, dcon::nation_id owner,
 	return dcon::nation_id{};
 }
 
+void build_migration_targets(sys::state& state, migration_buffer& pbuf, bool colonial) {
+	auto const pop_type_count = state.world.pop_type_size();
+	auto const nation_count = state.world.nation_size();
+	std::vector<uint8_t> shared(pop_type_count, 0);
+	for(uint32_t j = 0; j < pop_type_count; ++j) {
+		auto modifier = state.world.pop_type_get_migration_target(dcon::pop_type_id{ dcon::pop_type_id::value_base_t(j) });
+		shared[j] = modifier && !trigger::reads_this_or_from(state, modifier);
+	}
+
+	pbuf.targets.resize(size_t(nation_count) * pop_type_count);
+	concurrency::parallel_for(uint32_t(0), nation_count, [&](uint32_t i) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
+		static thread_local std::vector<float> weights;
+		for(uint32_t j = 0; j < pop_type_count; ++j) {
+			dcon::pop_type_id pt{ dcon::pop_type_id::value_base_t(j) };
+			auto& t = pbuf.targets[size_t(i) * pop_type_count + j];
+			t.provinces.clear();
+			t.shared = shared[j] != 0;
+			if(!t.shared)
+				continue;
+
+			// the same provinces, in the same order, as get_province_target_in_nation and
+			// get_colonial_province_target_in_nation would weigh for any pop of this type
+			bool limit_to_capitals = state.world.pop_type_get_state_capital_only(pt);
+			weights.clear();
+			for(auto loc : state.world.nation_get_province_ownership(n)) {
+				if(loc.get_province().get_is_colonial() != colonial)
+					continue;
+				if(limit_to_capitals && loc.get_province().get_state_membership().get_capital().id != loc.get_province().id)
+					continue;
+				float weight = province_migration_weight(state, pt, loc.get_province(), dcon::pop_id{});
+				if(weight > 0.0f) {
+					t.provinces.push_back(loc.get_province());
+					weights.push_back(weight);
+				}
+			}
+			if(!weights.empty())
+				t.table.build(weights);
+		}
+	});
+}
+
+void build_immigration_weights(sys::state& state, migration_buffer& pbuf) {
+	auto const pop_type_count = state.world.pop_type_size();
+	auto const nation_count = state.world.nation_size();
+	pbuf.shared_nation_weights.assign(pop_type_count, 0);
+	for(uint32_t j = 0; j < pop_type_count; ++j) {
+		auto modifier = state.world.pop_type_get_country_migration_target(dcon::pop_type_id{ dcon::pop_type_id::value_base_t(j) });
+		pbuf.shared_nation_weights[j] = modifier && !trigger::reads_this_or_from(state, modifier);
+	}
+
+	pbuf.nation_weights.assign(size_t(nation_count) * pop_type_count, 0.0f);
+	concurrency::parallel_for(uint32_t(0), nation_count, [&](uint32_t i) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
+		for(uint32_t j = 0; j < pop_type_count; ++j) {
+			if(pbuf.shared_nation_weights[j])
+				pbuf.nation_weights[size_t(i) * pop_type_count + j] = nation_immigration_weight(state, dcon::pop_type_id{ dcon::pop_type_id::value_base_t(j) }, n, dcon::pop_id{});
+		}
+	});
+}
+
+// the shared targets of the pops of nation n and type pt, or nullptr if each pop has to weigh the provinces for itself
+migration_targets const* find_migration_targets(sys::state& state, migration_buffer const& pbuf, dcon::nation_id n, dcon::pop_type_id pt) {
+	if(!n || !pt)
+		return nullptr;
+	auto const& t = pbuf.targets[size_t(n.index()) * state.world.pop_type_size() + pt.index()];
+	return t.shared ? &t : nullptr;
+}
+
+dcon::province_id draw_migration_target(sys::state& state, migration_targets const& t, dcon::pop_id p, uint32_t salt) {
+	if(t.provinces.empty())
+		return dcon::province_id{};
+	return t.provinces[t.table.draw(rng::get_random(state, (uint32_t(p.index()) << 2) | salt))];
+}
+
 } // namespace impl
 
+void alias_table::build(std::vector<float> const& weights) {
+	auto const count = uint32_t(weights.size());
+	threshold.resize(count);
+	alias.resize(count);
+
+	double total = 0.0;
+	for(auto w : weights)
+		total += double(w);
+
+	// every column starts with its weight scaled so that the mean is one; an underfull column is topped up from an
+	// overfull one, which becomes its alias
+	static thread_local std::vector<double> scaled;
+	static thread_local std::vector<uint32_t> underfull;
+	static thread_local std::vector<uint32_t> overfull;
+	scaled.resize(count);
+	underfull.clear();
+	overfull.clear();
+	for(uint32_t i = 0; i < count; ++i) {
+		scaled[i] = double(weights[i]) * double(count) / total;
+		if(scaled[i] < 1.0)
+			underfull.push_back(i);
+		else
+			overfull.push_back(i);
+	}
+	while(!underfull.empty() && !overfull.empty()) {
+		auto small = underfull.back();
+		underfull.pop_back();
+		auto large = overfull.back();
+		overfull.pop_back();
+
+		threshold[small] = float(scaled[small]);
+		alias[small] = large;
+		scaled[large] = (scaled[large] + scaled[small]) - 1.0;
+		if(scaled[large] < 1.0)
+			underfull.push_back(large);
+		else
+			overfull.push_back(large);
+	}
+	// whatever is left over is full, up to rounding
+	for(auto i : overfull) {
+		threshold[i] = 1.0f;
+		alias[i] = i;
+	}
+	for(auto i : underfull) {
+		threshold[i] = 1.0f;
+		alias[i] = i;
+	}
+}
+
+uint32_t alias_table::draw(uint64_t random_value) const {
+	auto column = rng::reduce(uint32_t(random_value >> 32), size());
+	auto coin = float(random_value & 0xFFFFFF) / float(0x1000000);
+	return coin < threshold[column] ? column : alias[column];
+}
+
 void update_internal_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
 	pbuf.update(state.world.pop_size());
+	impl::build_migration_targets(state, pbuf, false);
 
 	pexecute_staggered_blocks(offset, divisions, state.world.pop_size(), [&](auto ids) {
 		pbuf.amounts.set(ids, 0.0f);
@@ -3480,7 +3161,8 @@ void update_internal_migration(sys::state& state, uint32_t offset, uint32_t divi
 					if(state.world.pop_get_poptype(p) == state.culture_definitions.slaves)
 						return; // early exit
 
-					auto dest = impl::get_province_target_in_nation(state, owner, p);
+					auto targets = impl::find_migration_targets(state, pbuf, owner, state.world.pop_get_poptype(p));
+					auto dest = targets ? impl::draw_migration_target(state, *targets, p, 1) : impl::get_province_target_in_nation(state, owner, p);
 
 					//if(pop_size < small_pop_size) {
 					//	pbuf.amounts.set(p, pop_size);
@@ -3517,6 +3199,7 @@ float get_estimated_internal_migration(sys::state& state, dcon::pop_id ids) {
 
 void update_colonial_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
 	pbuf.update(state.world.pop_size());
+	impl::build_migration_targets(state, pbuf, true);
 
 	pexecute_staggered_blocks(offset, divisions, state.world.pop_size(), [&](auto ids) {
 		pbuf.amounts.set(ids, 0.0f);
@@ -3560,7 +3243,11 @@ void update_colonial_migration(sys::state& state, uint32_t offset, uint32_t divi
 					pbuf.amounts.set(p, std::min(pop_size, std::ceil(amount)));
 					//}
 
-					auto dest = impl::get_colonial_province_target_in_nation(state, owner, p);
+					// pops of a culture without a group can only move within their continent, which the shared targets don't know about
+					auto targets = impl::find_migration_targets(state, pbuf, owner, pt);
+					auto dest = targets && state.world.culture_get_group_from_culture_group_membership(state.world.pop_get_culture(p))
+						? impl::draw_migration_target(state, *targets, p, 2)
+						: impl::get_colonial_province_target_in_nation(state, owner, p);
 					pbuf.destinations.set(p, dest);
 				},
 				ids, loc, owners, amounts, pop_sizes);
@@ -3600,6 +3287,8 @@ float get_estimated_colonial_migration(sys::state& state, dcon::pop_id ids) {
 
 void update_immigration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
 	pbuf.update(state.world.pop_size());
+	impl::build_migration_targets(state, pbuf, false);
+	impl::build_immigration_weights(state, pbuf);
 
 	pexecute_staggered_blocks(offset, divisions, state.world.pop_size(), [&](auto ids) {
 		pbuf.amounts.set(ids, 0.0f);
@@ -3646,8 +3335,9 @@ void update_immigration(sys::state& state, uint32_t offset, uint32_t divisions,
 						pbuf.amounts.set(p, std::min(pop_size, std::ceil(amount)));
 					//}
 
-					auto ndest = impl::get_immigration_target(state, owner, p, state.current_date);
-					auto dest = impl::get_province_target_in_nation(state, ndest, p);
+					auto ndest = impl::get_immigration_target(state, owner, p, state.current_date, &pbuf);
+					auto targets = impl::find_migration_targets(state, pbuf, ndest, state.world.pop_get_poptype(p));
+					auto dest = targets ? impl::draw_migration_target(state, *targets, p, 1) : impl::get_province_target_in_nation(state, ndest, p);
 
 					pbuf.destinations.set(p, dest);
 				},
@@ -3679,7 +3369,7 @@ void estimate_directed_immigration(sys::state& state, dcon::nation_id n, std::ve
 		int32_t day_adjustment = day_of_month - int32_t(ymd_date.day);
 		auto est_amount = get_estimated_emigration(state, ids);
 		if(est_amount > 0.0f) {
-			auto target = impl::get_immigration_target(state, owners, ids, state.current_date + day_adjustment);
+			auto target = impl::get_immigration_target(state, owners, ids, state.current_date + day_adjustment, nullptr);
 			if(owners == n) {
 				if(target && uint32_t(target.index()) < sz) {
 					national_amounts[uint32_t(target.index())] -= est_amount;
@@ -3721,20 +3411,32 @@ float get_estimated_emigration(sys::state& state, dcon::pop_id ids) {
 }
 
 namespace impl {
-dcon::pop_id find_or_make_pop(sys::state& state, dcon::province_id loc, dcon::culture_id cid, dcon::religion_id rid,
-		dcon::pop_type_id ptid, float l) {
+dcon::pop_type_id adjusted_pop_type(sys::state& state, dcon::province_id loc, dcon::pop_type_id ptid) {
 	bool is_mine = state.world.commodity_get_is_mine(state.world.province_get_rgo(loc));
 	if(is_mine && ptid == state.culture_definitions.farmers) {
-		ptid = state.culture_definitions.laborers;
+		return state.culture_definitions.laborers;
 	} else if(!is_mine && ptid == state.culture_definitions.laborers) {
-		ptid = state.culture_definitions.farmers;
+		return state.culture_definitions.farmers;
 	}
 	// TODO: fix state capital only type pops ?
+	return ptid;
+}
+
+dcon::pop_id find_pop(sys::state& state, dcon::province_id loc, dcon::culture_id cid, dcon::religion_id rid, dcon::pop_type_id ptid) {
 	for(auto pl : state.world.province_get_pop_location(loc)) {
 		if(pl.get_pop().get_culture() == cid && pl.get_pop().get_religion() == rid && pl.get_pop().get_poptype() == ptid) {
 			return pl.get_pop();
 		}
 	}
+	return dcon::pop_id{};
+}
+
+dcon::pop_id find_or_make_pop(sys::state& state, dcon::province_id loc, dcon::culture_id cid, dcon::religion_id rid,
+		dcon::pop_type_id ptid, float l) {
+	ptid = adjusted_pop_type(state, loc, ptid);
+	if(auto existing = find_pop(state, loc, cid, rid, ptid); existing) {
+		return existing;
+	}
 	auto np = fatten(state.world, state.world.create_pop());
 	state.world.force_create_pop_location(np, loc);
 	np.set_culture(cid);
@@ -3826,99 +3528,155 @@ dcon::pop_id find_or_make_pop(sys::state& state, dcon::province_id loc, dcon::cu
 }
 } // namespace impl
 
-void apply_type_changes(sys::state& state, uint32_t offset, uint32_t divisions, promotion_buffer& pbuf) {
-	execute_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), [&](auto ids) {
+template<typename F>
+void gather_staggered_blocks(uint32_t offset, uint32_t divisions, uint32_t max, pop_transfer_list& out, F&& functor) {
+	// each block gathers into its own list, and the lists are joined in block order afterwards,
+	// so the result is the same as going through the blocks one by one
+	out.transfers.clear();
+	auto const first_block = 16 * offset;
+	auto const block_advance = 16 * divisions;
+
+	assert(divisions > 10);
+
+	if(first_block >= max)
+		return;
+	auto const block_count = (max - first_block + block_advance - 1) / block_advance;
+	if(out.blocks.size() < block_count)
+		out.blocks.resize(block_count);
+
+	concurrency::parallel_for(uint32_t(0), block_count, [&](uint32_t b) {
+		auto& dest = out.blocks[b];
+		dest.clear();
+		auto const block_index = first_block + b * block_advance;
+		for(uint32_t i = 0; i < executions_per_block; ++i) {
+			functor(ve::contiguous_tags<dcon::pop_id>(block_index + i * ve::vector_size), dest);
+		}
+	});
+
+	for(uint32_t b = 0; b < block_count; ++b) {
+		out.transfers.insert(out.transfers.end(), out.blocks[b].begin(), out.blocks[b].end());
+	}
+}
+
+pop_transfer make_transfer(sys::state& state, dcon::pop_id source, dcon::province_id loc, dcon::culture_id cid, dcon::religion_id rid,
+		dcon::pop_type_id ptid, float amount, pop_transfer_kind kind) {
+	ptid = impl::adjusted_pop_type(state, loc, ptid);
+	return pop_transfer{ source, impl::find_pop(state, loc, cid, rid, ptid), loc, cid, rid, ptid, amount,
+		pop_demographics::get_literacy(state, source), kind };
+}
+
+void gather_type_changes(sys::state& state, uint32_t offset, uint32_t divisions, promotion_buffer& pbuf, pop_transfer_list& out) {
+	gather_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), out, [&](auto ids, std::vector<pop_transfer>& dest) {
 		ve::apply(
 				[&](dcon::pop_id p) {
 					if(pbuf.amounts.get(p) > 0.0f && pbuf.types.get(p)) {
-						auto target_pop = impl::find_or_make_pop(state, state.world.pop_get_province_from_pop_location(p),
-								state.world.pop_get_culture(p), state.world.pop_get_religion(p), pbuf.types.get(p), pop_demographics::get_literacy(state, p));
-						state.world.pop_get_size(p) -= pbuf.amounts.get(p);
-						state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
+						dest.push_back(make_transfer(state, p, state.world.pop_get_province_from_pop_location(p), state.world.pop_get_culture(p),
+								state.world.pop_get_religion(p), pbuf.types.get(p), pbuf.amounts.get(p), pop_transfer_kind::other));
 					}
 				},
 				ids);
 	});
 }
 
-void apply_assimilation(sys::state& state, uint32_t offset, uint32_t divisions, assimilation_buffer& pbuf) {
-	auto exec_fn = [&](auto ids) {
+void gather_assimilation(sys::state& state, uint32_t offset, uint32_t divisions, assimilation_buffer& pbuf, pop_transfer_list& out) {
+	gather_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), out, [&](auto ids, std::vector<pop_transfer>& dest) {
 		auto locs = state.world.pop_get_province_from_pop_location(ids);
 		ve::apply([&](dcon::pop_id p, dcon::province_id l, dcon::culture_id dac) {
 			if(pbuf.amounts.get(p) > 0.0f) {
-				//auto o = nations::owner_of_pop(state, p);
 				auto cul = dac ? dac : state.world.province_get_dominant_culture(l);
 				auto rel = dac
 					? state.world.nation_get_religion(nations::owner_of_pop(state, p))
 					: state.world.province_get_dominant_religion(l);
 				assert(state.world.pop_get_poptype(p));
-				auto target_pop = impl::find_or_make_pop(state, l, cul, rel, state.world.pop_get_poptype(p), pop_demographics::get_literacy(state, p));
-				state.world.pop_get_size(p) -= pbuf.amounts.get(p);
-				state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
+				dest.push_back(make_transfer(state, p, l, cul, rel, state.world.pop_get_poptype(p), pbuf.amounts.get(p), pop_transfer_kind::other));
 			}
 		},
 		ids, locs, state.world.province_get_dominant_accepted_culture(locs));
-		};
-	execute_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), exec_fn);
+	});
 }
 
-void apply_internal_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
-	execute_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), [&](auto ids) {
+void gather_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf, pop_transfer_list& out, pop_transfer_kind kind) {
+	gather_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), out, [&](auto ids, std::vector<pop_transfer>& dest) {
 		ve::apply(
 				[&](dcon::pop_id p) {
 					if(pbuf.amounts.get(p) > 0.0f && pbuf.destinations.get(p)) {
 						assert(state.world.pop_get_poptype(p));
-						auto target_pop = impl::find_or_make_pop(state, pbuf.destinations.get(p), state.world.pop_get_culture(p),
-								state.world.pop_get_religion(p), state.world.pop_get_poptype(p), pop_demographics::get_literacy(state, p));
-						state.world.pop_get_size(p) -= pbuf.amounts.get(p);
-						state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
-						state.world.province_get_daily_net_migration(state.world.pop_get_province_from_pop_location(p)) -=
-								pbuf.amounts.get(p);
-						state.world.province_get_daily_net_migration(pbuf.destinations.get(p)) += pbuf.amounts.get(p);
+						dest.push_back(make_transfer(state, p, pbuf.destinations.get(p), state.world.pop_get_culture(p),
+								state.world.pop_get_religion(p), state.world.pop_get_poptype(p), pbuf.amounts.get(p), kind));
 					}
 				},
 				ids);
 	});
 }
 
+void gather_internal_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf, pop_transfer_list& out) {
+	gather_migration(state, offset, divisions, pbuf, out, pop_transfer_kind::internal_migration);
+}
+
+void gather_colonial_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf, pop_transfer_list& out) {
+	gather_migration(state, offset, divisions, pbuf, out, pop_transfer_kind::internal_migration);
+}
+
+void gather_immigration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf, pop_transfer_list& out) {
+	gather_migration(state, offset, divisions, pbuf, out, pop_transfer_kind::immigration);
+}
+
+void apply_pop_transfers(sys::state& state, pop_transfer_list const* lists, uint32_t count) {
+	for(uint32_t i = 0; i < count; ++i) {
+		for(auto const& t : lists[i].transfers) {
+			// a target that didn't exist while gathering may have been made by an earlier transfer since then
+			auto target_pop = t.target ? t.target : impl::find_or_make_pop(state, t.location, t.culture, t.religion, t.type, t.literacy);
+
+			state.world.pop_get_size(t.source) -= t.amount;
+			state.world.pop_get_size(target_pop) += t.amount;
+			mark_changed(state, state.world.pop_get_province_from_pop_location(t.source));
+			mark_changed(state, state.world.pop_get_province_from_pop_location(target_pop));
+
+			switch(t.kind) {
+			case pop_transfer_kind::internal_migration:
+				state.world.province_get_daily_net_migration(state.world.pop_get_province_from_pop_location(t.source)) -= t.amount;
+				state.world.province_get_daily_net_migration(t.location) += t.amount;
+				break;
+			case pop_transfer_kind::immigration:
+				state.world.province_get_daily_net_immigration(state.world.pop_get_province_from_pop_location(t.source)) -= t.amount;
+				state.world.province_get_daily_net_immigration(t.location) += t.amount;
+				state.world.province_set_last_immigration(t.location, state.current_date);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+}
+
+void apply_type_changes(sys::state& state, uint32_t offset, uint32_t divisions, promotion_buffer& pbuf) {
+	pop_transfer_list list;
+	gather_type_changes(state, offset, divisions, pbuf, list);
+	apply_pop_transfers(state, &list, 1);
+}
+
+void apply_assimilation(sys::state& state, uint32_t offset, uint32_t divisions, assimilation_buffer& pbuf) {
+	pop_transfer_list list;
+	gather_assimilation(state, offset, divisions, pbuf, list);
+	apply_pop_transfers(state, &list, 1);
+}
+
+void apply_internal_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
+	pop_transfer_list list;
+	gather_internal_migration(state, offset, divisions, pbuf, list);
+	apply_pop_transfers(state, &list, 1);
+}
+
 void apply_colonial_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
-	execute_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), [&](auto ids) {
-		ve::apply(
-				[&](dcon::pop_id p) {
-					if(pbuf.amounts.get(p) > 0.0f && pbuf.destinations.get(p)) {
-						assert(state.world.pop_get_poptype(p));
-						auto target_pop = impl::find_or_make_pop(state, pbuf.destinations.get(p), state.world.pop_get_culture(p),
-								state.world.pop_get_religion(p), state.world.pop_get_poptype(p), pop_demographics::get_literacy(state, p));
-						state.world.pop_get_size(p) -= pbuf.amounts.get(p);
-						state.world.pop_get_size(target_pop) += pbuf.amounts.get(p);
-						state.world.province_get_daily_net_migration(state.world.pop_get_province_from_pop_location(p)) -=
-								pbuf.amounts.get(p);
-						state.world.province_get_daily_net_migration(pbuf.destinations.get(p)) += pbuf.amounts.get(p);
-					}
-				},
-				ids);
-	});
+	pop_transfer_list list;
+	gather_colonial_migration(state, offset, divisions, pbuf, list);
+	apply_pop_transfers(state, &list, 1);
 }
 
 void apply_immigration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf) {
-	execute_staggered_blocks(offset, divisions, std::min(state.world.pop_size(), pbuf.size), [&](auto ids) {
-		ve::apply(
-				[&](dcon::pop_id p) {
-					auto amount = pbuf.amounts.get(p);
-					if(amount > 0.0f && pbuf.destinations.get(p)) {
-						assert(state.world.pop_get_poptype(p));
-						auto target_pop = impl::find_or_make_pop(state, pbuf.destinations.get(p), state.world.pop_get_culture(p),
-								state.world.pop_get_religion(p), state.world.pop_get_poptype(p), pop_demographics::get_literacy(state, p));
-
-						state.world.pop_get_size(p) -= amount;
-						state.world.pop_get_size(target_pop) += amount;
-						state.world.province_get_daily_net_immigration(state.world.pop_get_province_from_pop_location(p)) -= amount;
-						state.world.province_get_daily_net_immigration(pbuf.destinations.get(p)) += amount;
-						state.world.province_set_last_immigration(pbuf.destinations.get(p), state.current_date);
-					}
-				},
-				ids);
-	});
+	pop_transfer_list list;
+	gather_immigration(state, offset, divisions, pbuf, list);
+	apply_pop_transfers(state, &list, 1);
 }
 
 void remove_size_zero_pops(sys::state& state) {
@@ -3926,6 +3684,7 @@ void remove_size_zero_pops(sys::state& state) {
 	for(auto last = state.world.pop_size(); last-- > 0;) {
 		dcon::pop_id m{dcon::pop_id::value_base_t(last)};
 		if(state.world.pop_get_size(m) < 1.0f) {
+			mark_changed(state, state.world.pop_get_province_from_pop_location(m));
 			state.world.delete_pop(m);
 		}
 	}
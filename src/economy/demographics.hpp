@@ -178,6 +178,13 @@ dcon::demographics_key to_employment_key(sys::state const& state, dcon::pop_type
 uint32_t size(sys::state const& state);
 
 void regenerate_jingoism_support(sys::state& state, dcon::nation_id n);
+void update_pop_province_index(sys::state& state); // called by regenerate_from_pop_data_* and alt_regenerate_from_pop_data_*
+// the culture, ideology, issue option and religion totals of a province are only summed again by the daily update when
+// something marked it as changed (or when its turn in the rotation comes up); the full update sums everything. This is
+// the multiplayer daily update only: the single player one runs alongside the rest of the tick, while provinces are
+// still being marked, so it keeps summing a rotating group of those keys for every province instead
+void mark_changed(sys::state& state, dcon::province_id p);
+void mark_changed_pops(sys::state& state, uint32_t offset, uint32_t divisions); // the provinces of a staggered block of pops
 void regenerate_from_pop_data_full(sys::state& state);
 void alt_regenerate_from_pop_data_full(sys::state& state);
 void regenerate_from_pop_data_daily(sys::state& state);
@@ -255,9 +262,32 @@ struct assimilation_buffer {
 	}
 };
 
+// Walker's alias method, as arranged by Vose: once built from a list of weights, a draw picks an index with probability
+// proportional to its weight with one random number and two lookups
+struct alias_table {
+	std::vector<float> threshold;
+	std::vector<uint32_t> alias;
+
+	void build(std::vector<float> const& weights); // the weights must be positive
+	uint32_t draw(uint64_t random_value) const; // the table must not be empty
+	uint32_t size() const {
+		return uint32_t(threshold.size());
+	}
+};
+
+// where the pops of one nation and pop type may migrate to, when the weights don't depend on the pop itself
+struct migration_targets {
+	std::vector<dcon::province_id> provinces;
+	alias_table table;
+	bool shared = false; // otherwise each pop has to weigh the provinces for itself
+};
+
 struct migration_buffer {
 	ve::vectorizable_buffer<float, dcon::pop_id> amounts;
 	ve::vectorizable_buffer<dcon::province_id, dcon::pop_id> destinations;
+	std::vector<migration_targets> targets; // nation * pop_type_size + pop type, rebuilt on each update
+	std::vector<float> nation_weights; // immigration: nation * pop_type_size + pop type
+	std::vector<uint8_t> shared_nation_weights; // immigration: by pop type, whether nation_weights can be used
 	uint32_t size = 0;
 	uint32_t reserved = 0;
 
@@ -272,6 +302,27 @@ struct migration_buffer {
 	}
 };
 
+// Moving part of one pop into another pop, which may not exist yet. Type changes, assimilation and migration are first
+// gathered as transfers (which can be done in parallel, since it doesn't change anything), and then applied in order.
+enum class pop_transfer_kind : uint8_t {
+	other, internal_migration, immigration
+};
+struct pop_transfer {
+	dcon::pop_id source;
+	dcon::pop_id target; // invalid if no matching pop existed when the transfer was gathered
+	dcon::province_id location;
+	dcon::culture_id culture;
+	dcon::religion_id religion;
+	dcon::pop_type_id type;
+	float amount = 0.0f;
+	float literacy = 0.0f; // of the source, used if the target pop has to be made
+	pop_transfer_kind kind = pop_transfer_kind::other;
+};
+struct pop_transfer_list {
+	std::vector<pop_transfer> transfers;
+	std::vector<std::vector<pop_transfer>> blocks; // scratch space: one list per block of pops while gathering
+};
+
 void update_literacy(sys::state& state, uint32_t offset, uint32_t divisions);
 void update_consciousness(sys::state& state, uint32_t offset, uint32_t divisions);
 void update_militancy(sys::state& state, uint32_t offset, uint32_t divisions);
@@ -291,6 +342,15 @@ float get_estimated_promotion(sys::state& state, dcon::nation_id n);
 
 void apply_ideologies(sys::state& state, uint32_t offset, uint32_t divisions, ideology_buffer& pbuf);
 void apply_issues(sys::state& state, uint32_t offset, uint32_t divisions, issues_buffer& pbuf);
+// these only read the game state, so they may all run at the same time
+void gather_type_changes(sys::state& state, uint32_t offset, uint32_t divisions, promotion_buffer& pbuf, pop_transfer_list& out);
+void gather_assimilation(sys::state& state, uint32_t offset, uint32_t divisions, assimilation_buffer& pbuf, pop_transfer_list& out);
+void gather_internal_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf, pop_transfer_list& out);
+void gather_colonial_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf, pop_transfer_list& out);
+void gather_immigration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf, pop_transfer_list& out);
+// applies the lists one after another, making any missing pops; the result is the same as applying each change serially
+void apply_pop_transfers(sys::state& state, pop_transfer_list const* lists, uint32_t count);
+
 void apply_type_changes(sys::state& state, uint32_t offset, uint32_t divisions, promotion_buffer& pbuf);
 void apply_assimilation(sys::state& state, uint32_t offset, uint32_t divisions, assimilation_buffer& pbuf);
 void apply_internal_migration(sys::state& state, uint32_t offset, uint32_t divisions, migration_buffer& pbuf);
@@ -479,6 +479,14 @@ void convert_commodities_into_ingredients(
 	});
 }
 
+// presimulation ramps the starting savings of pops down to nothing in a fixed number of stages, every one of which is
+// simulated. A stage ends once prices and employment have moved less than the tolerances below for a few steps in a row
+// (or after its share of the steps), and presimulation ends as soon as the last stage has settled
+constexpr inline float presimulation_price_tolerance = 0.001f;		// relative change of a price in one step
+constexpr inline float presimulation_employment_tolerance = 0.001f;	// change of the employment of a factory in one step
+constexpr inline uint32_t presimulation_settled_steps = 3;
+constexpr inline uint32_t presimulation_ramp_stages = 32;
+
 void presimulate(sys::state& state) {
 	// economic updates without construction
 #ifdef NDEBUG
@@ -486,10 +494,66 @@ void presimulate(sys::state& state) {
 #else
 	uint32_t steps = 2;
 #endif
-	for(uint32_t i = 0; i < steps; i++) {
-		update_factory_employment(state);
-		daily_update(state, true, (float)i / (float)steps);
-		ai::update_budget(state);
+	static auto const phase = profiler::register_phase("economy::presimulate");
+	profiler::scope ps{ phase };
+
+	auto markets = state.world.market_size();
+	auto commodities = state.world.commodity_size();
+	std::vector<float> last_price(size_t(markets) * commodities, 0.f);
+	std::vector<float> last_employment(state.world.factory_size() * 3, 0.f);
+
+	auto step_delta_is_small = [&]() {
+		bool small = true;
+		for(uint32_t m = 0; m < markets; m++) {
+			for(uint32_t c = 0; c < commodities; c++) {
+				auto price = state.world.market_get_price(dcon::market_id{ dcon::market_id::value_base_t(m) }, dcon::commodity_id{ dcon::commodity_id::value_base_t(c) });
+				auto& last = last_price[size_t(m) * commodities + c];
+				if(std::abs(price - last) > presimulation_price_tolerance * std::max(last, 0.0001f))
+					small = false;
+				last = price;
+			}
+		}
+		last_employment.resize(state.world.factory_size() * 3, 0.f);
+		state.world.for_each_factory([&](dcon::factory_id f) {
+			float current[3] = {
+				state.world.factory_get_unqualified_employment(f),
+				state.world.factory_get_primary_employment(f),
+				state.world.factory_get_secondary_employment(f)
+			};
+			for(uint32_t k = 0; k < 3; k++) {
+				auto& last = last_employment[size_t(f.index()) * 3 + k];
+				if(std::abs(current[k] - last) > presimulation_employment_tolerance)
+					small = false;
+				last = current[k];
+			}
+		});
+		return small;
+	};
+
+	// the budget update of one step and the employment update of the next both only read what daily_update left behind
+	// and write disjoint data (national spending settings and factory employment), so they run side by side
+	update_factory_employment(state);
+	uint32_t const stages = std::min(presimulation_ramp_stages, steps);
+	uint32_t const steps_per_stage = steps / stages;
+	for(uint32_t stage = 0; stage < stages; stage++) {
+		uint32_t settled = 0;
+		for(uint32_t i = 0; ; i++) {
+			daily_update(state, true, float(stage) / float(stages));
+
+			settled = step_delta_is_small() ? settled + 1 : 0;
+			bool stage_done = settled >= presimulation_settled_steps || i + 1 >= steps_per_stage;
+			if(stage_done && stage + 1 == stages) {
+				ai::update_budget(state);
+				return;
+			}
+			concurrency::parallel_invoke([&]() {
+				ai::update_budget(state);
+			}, [&]() {
+				update_factory_employment(state);
+			});
+			if(stage_done)
+				break;
+		}
 	}
 }
 
@@ -1416,7 +1480,7 @@ void update_pops_employment(sys::state& state) {
 }
 
 void update_factory_employment(sys::state& state) {
-	state.world.execute_serial_over_factory([&](auto facids) {
+	state.world.execute_parallel_over_factory([&](auto facids) {
 		auto pid = state.world.factory_get_province_from_factory_location(facids);
 		auto sid = state.world.province_get_state_membership(pid);
 		auto mid = state.world.state_instance_get_market_from_local_market(sid);
@@ -1792,197 +1856,237 @@ float factory_desired_raw_profit(dcon::factory_id fac, float spendings) {
 	return spendings * 1.01f;
 }
 
-void update_single_factory_consumption(
-	sys::state& state,
-	dcon::factory_id f,
-	dcon::province_id p,
-	dcon::state_instance_id s,
-	dcon::market_id m,
-	dcon::nation_id n,
-	float mobilization_impact,
-	bool occupied
-) {
-	auto fac = fatten(state.world, f);
-	auto fac_type = fac.get_building_type();
+// the consumption of every factory, as vector passes over factories: everything that only depends on the factory and
+// its location is computed here in parallel, and the demand is registered afterwards, per market, by
+// register_factory_demand, so that it is added up in the same order as before
+void update_factories_consumption(sys::state& state) {
+	auto owner_fraction = state.world.state_instance_make_vectorizable_float_buffer();
+	state.world.execute_serial_over_state_instance([&](auto states) {
+		auto total_state_pop = ve::max(0.01f, state.world.state_instance_get_demographics(states, demographics::total));
+		auto capitalists = state.world.state_instance_get_demographics(states, demographics::to_key(state, state.culture_definitions.capitalists));
+		owner_fraction.set(states, ve::min(0.05f, capitalists / total_state_pop));
+	});
 
-	assert(fac_type);
-	assert(fac_type.get_output());
-	assert(n);
-	assert(p);
-	assert(s);
+	state.world.execute_parallel_over_factory([&](auto facids) {
+		auto p = state.world.factory_get_province_from_factory_location(facids);
+		auto s = state.world.province_get_state_membership(p);
+		auto m = state.world.state_instance_get_market_from_local_market(s);
+		auto n = state.world.state_instance_get_nation_from_state_ownership(s);
+		auto fac_type = state.world.factory_get_building_type(facids);
+		auto output = state.world.factory_type_get_output(fac_type);
+		auto level = ve::to_float(state.world.factory_get_level(facids));
+
+		auto has_owner = n != dcon::nation_id{};
+		auto mobilization = ve::select(
+			state.world.nation_get_is_mobilized(n),
+			military::ve_mobilization_impact(state, n), 1.f
+		);
 
-	//inputs
+		//inputs
+
+		auto input_total = ve::apply([&](dcon::market_id market, dcon::factory_type_id ft) {
+			return ft ? factory_input_total_cost(state, market, ft) : 0.f;
+		}, m, fac_type);
+		auto min_input_available = ve::apply([&](dcon::market_id market, dcon::factory_type_id ft) {
+			return ft ? factory_min_input_available(state, market, ft) : 0.f;
+		}, m, fac_type);
+		auto e_input_total = ve::apply([&](dcon::market_id market, dcon::factory_type_id ft) {
+			return ft ? factory_e_input_total_cost(state, market, ft) : 0.f;
+		}, m, fac_type);
+		auto min_e_input_available = ve::apply([&](dcon::market_id market, dcon::factory_type_id ft) {
+			return ft ? factory_min_e_input_available(state, market, ft) : 0.f;
+		}, m, fac_type);
+		auto price_output = ve::apply([&](dcon::market_id market, dcon::commodity_id c) {
+			return c ? price(state, market, c) : 0.f;
+		}, m, output);
+
+		//modifiers
+
+		auto per_level_employment = ve::to_float(state.world.factory_type_get_base_workforce(fac_type));
+		auto max_employment = per_level_employment * level;
+		auto small_bound = per_level_employment * 5.f;
+		auto small_size_effect = ve::select(max_employment < small_bound, 0.5f + max_employment / small_bound * 0.5f, 1.f);
+		auto priority = ve::apply([&](dcon::nation_id owner, dcon::factory_type_id ft) {
+			return owner && ft ? priority_multiplier(state, ft, owner) : 1.f;
+		}, n, fac_type);
+
+		auto input_multiplier = ve::max(0.001f, small_size_effect
+			* state.world.factory_get_triggered_modifiers(facids)
+			* ve::max(
+				0.1f,
+				priority
+				* (
+					state.defines.alice_inputs_base_factor
+					+ state.world.province_get_modifier_values(p, sys::provincial_mod_offsets::local_factory_input)
+					+ state.world.nation_get_modifier_values(n, sys::national_mod_offsets::factory_input)
+					+ owner_fraction.get(s) * -2.5f
+				)
+			));
+		auto mfactor = state.world.nation_get_modifier_values(n, sys::national_mod_offsets::factory_maintenance) + 1.0f;
+
+		auto national_t = ve::apply([&](dcon::nation_id owner, dcon::commodity_id c) {
+			return owner && c ? state.world.nation_get_factory_goods_throughput(owner, c) : 0.f;
+		}, n, output);
+		auto throughput_multiplier = production_throughput_multiplier
+			* ve::max(0.f, 1.f + national_t)
+			* ve::max(0.f, 1.f + state.world.province_get_modifier_values(p, sys::provincial_mod_offsets::local_factory_throughput))
+			* ve::max(0.f, 1.f + state.world.nation_get_modifier_values(n, sys::national_mod_offsets::factory_throughput))
+			* (1.f + level / 100.f); // economies of scale throughput bonus
+
+		auto national_output = ve::apply([&](dcon::nation_id owner, dcon::commodity_id c) {
+			return owner && c ? state.world.nation_get_factory_goods_output(owner, c) : 0.f;
+		}, n, output);
+		auto output_multiplier_no_secondary_workers = ve::max(0.f,
+			national_output
+			+ state.world.province_get_modifier_values(p, sys::provincial_mod_offsets::local_factory_output)
+			+ state.world.nation_get_modifier_values(n, sys::national_mod_offsets::factory_output)
+			+ 1.0f
+		);
 
-	float input_total = factory_input_total_cost(state, m, fac_type);
-	float min_input_available = factory_min_input_available(state, m, fac_type);
-	float e_input_total = factory_e_input_total_cost(state, m, fac_type);
-	float min_e_input_available = factory_min_e_input_available(state, m, fac_type);
+		auto unqualified = state.world.factory_get_unqualified_employment(facids);
+		auto primary = state.world.factory_get_primary_employment(facids);
+		auto secondary = state.world.factory_get_secondary_employment(facids);
+		auto satisfaction_unqualified = state.world.market_get_labor_demand_satisfaction(m, labor::no_education);
+		auto satisfaction_primary = state.world.market_get_labor_demand_satisfaction(m, labor::basic_education);
+		auto satisfaction_secondary = state.world.market_get_labor_demand_satisfaction(m, labor::high_education);
 
-	//modifiers
+		auto output_multiplier = output_multiplier_no_secondary_workers
+			* (secondary * satisfaction_secondary * economy::secondary_employment_output_bonus + 1.0f);
 
-	float input_multiplier = factory_input_multiplier(state, fac, n, p, s);
-	auto const mfactor = state.world.nation_get_modifier_values(n, sys::national_mod_offsets::factory_maintenance) + 1.0f;
-	float throughput_multiplier = factory_throughput_multiplier(state, fac_type, n, p, s, fac.get_level());
-	float output_multiplier = factory_output_multiplier(state, fac, n, m, p);
-
-	float bonus_profit_thanks_to_max_e_input = fac_type.get_output_amount()
-		* 0.25f
-		* throughput_multiplier
-		* output_multiplier
-		* min_input_available
-		* price(state, m, fac_type.get_output());
-
-	// if efficiency inputs are not worth it, then do not buy them
-	if(bonus_profit_thanks_to_max_e_input < e_input_total * mfactor * input_multiplier)
-		min_e_input_available = 0.f;
-
-	//this value represents total production if 1 lvl of this factory is filled with workers
-	float total_production = fac_type.get_output_amount()
-		* (0.75f + 0.25f * min_e_input_available)
-		* throughput_multiplier
-		* output_multiplier
-		* min_input_available;
-
-	assert(min_input_available >= 0.f);
-	assert(output_multiplier >= 0.f);
-	assert(throughput_multiplier >= 0.f);
-	assert(min_e_input_available >= 0.f);
-
-	//this value represents raw profit if 1 lvl of this factory is filled with workers
-	float output_cost_per_employment_unit =
-		total_production
-		* price(state, m, fac_type.get_output());
-
-	float raw_profit_if_inputs_were_satisfied =
-		fac_type.get_output_amount()
-		* throughput_multiplier
-		* output_multiplier
-		* price(state, m, fac_type.get_output());
-
-	fac.set_output_cost_per_worker(
-		fac_type.get_output_amount()
-		* (0.75f + 0.25f * min_e_input_available)
-		* min_input_available
-		* throughput_multiplier
-		* factory_output_multiplier_no_secondary_workers(state, fac, n, p)
-		* price(state, m, fac_type.get_output())
-	);
+		auto output_amount = state.world.factory_type_get_output_amount(fac_type);
 
-	float base_spendings =
-		input_multiplier
-		* input_total
-		* min_input_available
-		+
-		input_multiplier
-		* mfactor
-		* e_input_total
-		* min_e_input_available;
-
-	float spending_on_inputs_if_inputs_were_satisfied =
-		input_multiplier
-		* input_total;
-
-	float spending_on_e_inputs_if_inputs_were_satisfied =
-		input_multiplier
-		* mfactor
-		* e_input_total;
-
-	assert(output_cost_per_employment_unit >= 0.f);
-	assert(base_spendings >= 0.f);
-
-	//these value represent spendings if 1 lvl of this factory is filled with workers
-
-	float input_cost_per_employment_unit =
-		input_multiplier
-		* throughput_multiplier
-		* input_total
-		* min_input_available
-		+
-		input_multiplier * mfactor
-		* e_input_total
-		* min_e_input_available
-		* min_input_available;
-
-	float base_throughput =
-		(
-			state.world.factory_get_unqualified_employment(fac)
-			* state.world.market_get_labor_demand_satisfaction(m, labor::no_education)
-			* unqualified_throughput_multiplier
-			+
-			state.world.factory_get_primary_employment(fac)
-			* state.world.market_get_labor_demand_satisfaction(m, labor::basic_education)
-		)
-		* state.world.factory_get_level(fac)
-		* factory_throughput_additional_multiplier(
-			state,
-			fac,
-			mobilization_impact,
-			occupied
+		// if efficiency inputs are not worth it, then do not buy them
+		auto bonus_profit_thanks_to_max_e_input = output_amount
+			* 0.25f
+			* throughput_multiplier
+			* output_multiplier
+			* min_input_available
+			* price_output;
+		min_e_input_available = ve::select(
+			bonus_profit_thanks_to_max_e_input < e_input_total * mfactor * input_multiplier,
+			0.f, min_e_input_available
 		);
 
-	auto max_employment = factory_max_employment(state, fac);
+		//this value represents total production if 1 lvl of this factory is filled with workers
+		auto total_production = output_amount
+			* (0.75f + 0.25f * min_e_input_available)
+			* throughput_multiplier
+			* output_multiplier
+			* min_input_available;
 
-	auto unqualified_labour_demand =
-		fac.get_unqualified_employment()
-		* max_employment;
-	auto unskilled_labour_demand =
-		fac.get_primary_employment()
-		* max_employment;
-	auto skilled_labour_demand =
-		fac.get_secondary_employment()
-		* max_employment;
+		//this value represents raw profit if 1 lvl of this factory is filled with workers
+		auto output_cost_per_employment_unit = total_production * price_output;
+		auto raw_profit_if_inputs_were_satisfied = output_amount * throughput_multiplier * output_multiplier * price_output;
 
-	assert(unqualified_labour_demand >= 0.f);
-	assert(unskilled_labour_demand >= 0.f);
-	assert(skilled_labour_demand >= 0.f);
+		auto output_cost_per_worker = output_amount
+			* (0.75f + 0.25f * min_e_input_available)
+			* min_input_available
+			* throughput_multiplier
+			* output_multiplier_no_secondary_workers
+			* price_output;
 
-	state.world.market_get_labor_demand(m, labor::no_education) += unqualified_labour_demand;
-	state.world.market_get_labor_demand(m, labor::basic_education) += unskilled_labour_demand;
-	state.world.market_get_labor_demand(m, labor::high_education) += skilled_labour_demand;
+		auto spending_on_inputs_if_inputs_were_satisfied = input_multiplier * input_total;
+		auto spending_on_e_inputs_if_inputs_were_satisfied = input_multiplier * mfactor * e_input_total;
 
-	auto& inputs = fac_type.get_inputs();
-	auto& e_inputs = fac_type.get_efficiency_inputs();
+		//these value represent spendings if 1 lvl of this factory is filled with workers
+		auto input_cost_per_employment_unit =
+			input_multiplier
+			* throughput_multiplier
+			* input_total
+			* min_input_available
+			+
+			input_multiplier * mfactor
+			* e_input_total
+			* min_e_input_available
+			* min_input_available;
+
+		auto occupied_factor = ve::apply([&](dcon::province_id location, dcon::nation_id owner) {
+			return state.world.province_get_nation_from_province_control(location) != owner ? 0.1f : 1.0f;
+		}, p, n);
+		auto base_throughput =
+			(
+				unqualified * satisfaction_unqualified * unqualified_throughput_multiplier
+				+ primary * satisfaction_primary
+			)
+			* level
+			* occupied_factor * ve::max(0.0f, mobilization);
+
+		// register real demand :
+		// input_multiplier * throughput_multiplier * level * primary_employment
+		// also multiply by target production scale...
+		// otherwise too much excess demand is generated
+		// also multiply by something related to minimal satisfied input
+		// to prevent generation of too much demand on rgos already
+		// influenced by a shortage
+		// to make this modifier even more sane
+		// we check our potential profit
+		// and check how much of this input
+		// we could potentially buy with our income
+
+		auto min_input_importance = ve::min(1.f, raw_profit_if_inputs_were_satisfied / (spending_on_inputs_if_inputs_were_satisfied + 0.00001f));
+		auto min_input_coefficient = min_input_importance + (1.f - min_input_importance) * min_input_available;
+
+		auto min_e_input_importance = ve::min(1.f, raw_profit_if_inputs_were_satisfied * 0.25f / (spending_on_e_inputs_if_inputs_were_satisfied + 0.00001f));
+		auto min_e_input_coefficient = min_e_input_importance + (1.f - min_e_input_importance) * min_e_input_available;
+
+		auto input_scale = input_multiplier * throughput_multiplier * base_throughput * min_input_coefficient;
+
+		auto actual_production = total_production * base_throughput;
+		auto actual_output_costs = output_cost_per_employment_unit * base_throughput;
+		auto actual_inputs_cost = input_cost_per_employment_unit * base_throughput;
+		auto actual_wages =
+			(
+				state.world.market_get_labor_price(m, labor::no_education) * satisfaction_unqualified * unqualified
+				+ state.world.market_get_labor_price(m, labor::basic_education) * satisfaction_primary * primary
+				+ state.world.market_get_labor_price(m, labor::high_education) * satisfaction_secondary * secondary
+			)
+			* level
+			* state.defines.alice_factory_per_level_employment;
 
-	// register real demand :
-	// input_multiplier * throughput_multiplier * level * primary_employment
-	// also multiply by target production scale...
-	// otherwise too much excess demand is generated
-	// also multiply by something related to minimal satisfied input
-	// to prevent generation of too much demand on rgos already
-	// influenced by a shortage
-	// to make this modifier even more sane
-	// we check our potential profit
-	// and check how much of this input
-	// we could potentially buy with our income
+#ifndef NDEBUG
+		ve::apply([&](bool valid, float a, float b, float c, float d) {
+			assert(!valid || (a >= 0.f && b >= 0.f && c >= 0.f && d >= 0.f));
+		}, has_owner, input_scale, actual_output_costs, throughput_multiplier, output_multiplier);
+#endif
 
-	auto min_input_importance = std::min(1.f, raw_profit_if_inputs_were_satisfied / (spending_on_inputs_if_inputs_were_satisfied + 0.00001f));
-	auto min_input_coefficient = (min_input_importance + (1.f - min_input_importance) * min_input_available);
+		// factories in provinces without an owner keep their values
+		state.world.factory_set_output_cost_per_worker(facids, ve::select(has_owner, output_cost_per_worker, state.world.factory_get_output_cost_per_worker(facids)));
+		state.world.factory_set_input_cost_per_worker(facids, ve::select(has_owner, input_cost_per_employment_unit, state.world.factory_get_input_cost_per_worker(facids)));
+		state.world.factory_set_actual_production(facids, ve::select(has_owner, actual_production, state.world.factory_get_actual_production(facids)));
+		state.world.factory_set_full_output_cost(facids, ve::select(has_owner, actual_output_costs, state.world.factory_get_full_output_cost(facids)));
+		state.world.factory_set_full_input_cost(facids, ve::select(has_owner, actual_inputs_cost, state.world.factory_get_full_input_cost(facids)));
+		state.world.factory_set_full_labor_cost(facids, ve::select(has_owner, actual_wages, state.world.factory_get_full_labor_cost(facids)));
+		state.world.factory_set_input_scale(facids, ve::select(has_owner, input_scale, 0.f));
+		state.world.factory_set_e_input_scale(facids, ve::select(has_owner, mfactor * input_scale * min_e_input_coefficient, 0.f));
+		ve::apply([&](dcon::factory_id f, bool valid, float profit) {
+			if(valid)
+				state.world.factory_set_unprofitable(f, profit <= 0.0f);
+		}, facids, has_owner, actual_output_costs - actual_inputs_cost - actual_wages);
+	});
+}
 
-	auto min_e_input_importance = std::min(1.f, raw_profit_if_inputs_were_satisfied * 0.25f / (spending_on_e_inputs_if_inputs_were_satisfied + 0.00001f));
-	auto min_e_input_coefficient = (min_e_input_importance + (1.f - min_e_input_importance) * min_e_input_available);
+// labor and input demand of one factory, from the values computed by update_factories_consumption
+void register_factory_demand(sys::state& state, dcon::factory_id f, dcon::market_id m) {
+	auto fac_type = state.world.factory_get_building_type(f);
+	auto max_employment = factory_max_employment(state, f);
 
-	assert(input_multiplier >= 0.f);
-	assert(throughput_multiplier >= 0.f);
-	assert(base_throughput >= 0.f);
-	assert(min_input_coefficient >= 0.f);
+	auto unqualified_labour_demand = state.world.factory_get_unqualified_employment(f) * max_employment;
+	auto unskilled_labour_demand = state.world.factory_get_primary_employment(f) * max_employment;
+	auto skilled_labour_demand = state.world.factory_get_secondary_employment(f) * max_employment;
 
-	float input_scale =
-		input_multiplier
-		* throughput_multiplier
-		* base_throughput
-		* min_input_coefficient;
+	assert(unqualified_labour_demand >= 0.f);
+	assert(unskilled_labour_demand >= 0.f);
+	assert(skilled_labour_demand >= 0.f);
 
-	assert(input_scale >= 0.f);
+	state.world.market_get_labor_demand(m, labor::no_education) += unqualified_labour_demand;
+	state.world.market_get_labor_demand(m, labor::basic_education) += unskilled_labour_demand;
+	state.world.market_get_labor_demand(m, labor::high_education) += skilled_labour_demand;
 
+	auto input_scale = state.world.factory_get_input_scale(f);
+	auto& inputs = state.world.factory_type_get_inputs(fac_type);
 	for(uint32_t i = 0; i < commodity_set::set_size; ++i) {
 		if(inputs.commodity_type[i]) {
-			register_intermediate_demand(state,
-				m,
-				inputs.commodity_type[i],
-				input_scale
-				* inputs.commodity_amounts[i]
-				, economy_reason::factory
-			);
+			register_intermediate_demand(state, m, inputs.commodity_type[i], input_scale * inputs.commodity_amounts[i], economy_reason::factory);
 		} else {
 			break;
 		}
@@ -1991,72 +2095,35 @@ void update_single_factory_consumption(
 	// and for efficiency inputs
 	//  the consumption of efficiency inputs is (national-factory-maintenance-modifier + 1) x input-multiplier x
 	//  throughput-multiplier x factory level
+	auto e_input_scale = state.world.factory_get_e_input_scale(f);
+	auto& e_inputs = state.world.factory_type_get_efficiency_inputs(fac_type);
 	for(uint32_t i = 0; i < small_commodity_set::set_size; ++i) {
 		if(e_inputs.commodity_type[i]) {
-			register_intermediate_demand(
-				state,
-				m,
-				e_inputs.commodity_type[i],
-				mfactor
-				* input_scale
-				* e_inputs.commodity_amounts[i]
-				* min_e_input_coefficient
-				, economy_reason::factory
-			);
+			register_intermediate_demand(state, m, e_inputs.commodity_type[i], e_input_scale * e_inputs.commodity_amounts[i], economy_reason::factory);
 		} else {
 			break;
 		}
 	}
-
-	float actual_production = total_production * base_throughput;
-	float actual_output_costs = output_cost_per_employment_unit * base_throughput;
-	float actual_inputs_cost = input_cost_per_employment_unit * base_throughput;
-
-	float actual_wages =
-		(
-			state.world.market_get_labor_price(m, labor::no_education)
-			* state.world.market_get_labor_demand_satisfaction(m, labor::no_education)
-			* state.world.factory_get_unqualified_employment(fac)
-			+
-			state.world.market_get_labor_price(m, labor::basic_education)
-			* state.world.market_get_labor_demand_satisfaction(m, labor::basic_education)
-			* state.world.factory_get_primary_employment(fac)
-			+
-			state.world.market_get_labor_price(m, labor::high_education)
-			* state.world.market_get_labor_demand_satisfaction(m, labor::high_education)
-			* state.world.factory_get_secondary_employment(fac)
-		)
-		* state.world.factory_get_level(fac)
-		* state.defines.alice_factory_per_level_employment;
-
-	fac.set_input_cost_per_worker(input_cost_per_employment_unit);
-	float desired_profit = factory_desired_raw_profit(fac, actual_inputs_cost + actual_wages);
-
-	float actual_profit = actual_output_costs - actual_inputs_cost - actual_wages;
-	state.world.factory_set_unprofitable(f, actual_profit <= 0.0f);
-
-	state.world.factory_set_actual_production(f, actual_production);
-
-	state.world.factory_set_full_output_cost(f, actual_output_costs);
-	state.world.factory_set_full_input_cost(f, actual_inputs_cost);
-	state.world.factory_set_full_labor_cost(f, actual_wages);
 }
 
-void update_single_factory_production(
-	sys::state& state,
-	dcon::factory_id f,
-	dcon::market_id m,
-	dcon::nation_id n
-) {
-	auto production = state.world.factory_get_actual_production(f);
-	if(production > 0) {
-		auto fac = fatten(state.world, f);
-		auto fac_type = fac.get_building_type();
-		auto total_output_cost_if_everything_was_sold = state.world.factory_get_full_output_cost(f);
-		auto real_output_cost = total_output_cost_if_everything_was_sold * state.world.market_get_supply_sold_ratio(m, fac_type.get_output());
-		state.world.factory_set_full_output_cost(f, real_output_cost);
-		register_domestic_supply(state, m, fac_type.get_output(), production, economy_reason::factory);
-	}
+// scales the output costs of factories by the share of their output that was actually sold
+void update_factories_production(sys::state& state) {
+	state.world.execute_parallel_over_factory([&](auto facids) {
+		auto s = state.world.province_get_state_membership(state.world.factory_get_province_from_factory_location(facids));
+		auto m = state.world.state_instance_get_market_from_local_market(s);
+		auto n = state.world.state_instance_get_nation_from_state_ownership(s);
+		auto output = state.world.factory_type_get_output(state.world.factory_get_building_type(facids));
+		auto sold_ratio = ve::apply([&](dcon::market_id market, dcon::commodity_id c) {
+			return market && c ? state.world.market_get_supply_sold_ratio(market, c) : 0.f;
+		}, m, output);
+		auto production = state.world.factory_get_actual_production(facids);
+		auto full_output_cost = state.world.factory_get_full_output_cost(facids);
+		state.world.factory_set_full_output_cost(facids, ve::select(
+			(n != dcon::nation_id{}) && (production > 0.f),
+			full_output_cost * sold_ratio,
+			full_output_cost
+		));
+	});
 }
 
 rgo_workers_breakdown rgo_relevant_population(sys::state& state, dcon::province_id p, dcon::nation_id n) {
@@ -2670,6 +2737,8 @@ spending_cost full_spending_cost(sys::state& state, dcon::nation_id n) {
 }
 
 float estimate_stockpile_filling_spending(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->stockpile_filling_spending;
 	float total = 0.0f;
 	uint32_t total_commodities = state.world.commodity_size();
 
@@ -2695,6 +2764,8 @@ float estimate_stockpile_filling_spending(sys::state& state, dcon::nation_id n)
 }
 
 float estimate_overseas_penalty_spending(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->overseas_penalty_spending;
 	float total = 0.0f;
 
 	auto capital = state.world.nation_get_capital(n);
@@ -3095,8 +3166,10 @@ void update_pop_consumption(
 			pop_size / state.defines.alice_needs_scaling_factor
 			* delayed_luxury_from_money;
 
+		// aggregate the pops into (market, pop type) strata
 		ve::apply([&](
 			dcon::market_id m,
+			dcon::nation_id nation,
 			float scale_life,
 			float scale_everyday,
 			float scale_luxury,
@@ -3113,14 +3186,13 @@ void update_pop_consumption(
 				state.world.market_get_life_needs_scale(m, pop_type) += scale_life;
 				state.world.market_get_everyday_needs_scale(m, pop_type) += scale_everyday;
 				state.world.market_get_luxury_needs_scale(m, pop_type) += scale_luxury;
-				auto zone = state.world.market_get_zone_from_local_market(m);
-				auto nation = state.world.state_instance_get_nation_from_state_ownership(zone);
 				state.world.nation_get_private_investment(nation) += investment;
 				if(nation == state.local_player_nation) {
 					state.ui_state.last_tick_investment_pool_change += investment;
 				}
 		},
 			markets,
+			nations,
 			final_demand_scale_life,
 			final_demand_scale_everyday,
 			final_demand_scale_luxury,
@@ -3137,8 +3209,11 @@ void update_pop_consumption(
 	state.console_log(debug_output);
 #endif // !NDEBUG
 
-	// iterate over all (market,pop type,trade good) pairs to finalise this calculation
-	state.world.execute_serial_over_market([&](auto ids) {
+	// the pops were aggregated into (market, pop type) strata above:
+	// now turn the scales of the strata into demand, one commodity at a time,
+	// summing the strata first so that each commodity is registered once per market
+	auto const pop_type_count = state.world.pop_type_size();
+	state.world.execute_parallel_over_market([&](auto ids) {
 		auto states = state.world.market_get_zone_from_local_market(ids);
 		auto nations = state.world.state_instance_get_nation_from_state_ownership(states);
 		auto invention_factor = state.defines.invention_impact_on_demand * invention_count.get(nations) + 1.f;
@@ -3168,60 +3243,55 @@ void update_pop_consumption(
 				nations, sys::national_mod_offsets::rich_luxury_needs) + 1.0f,
 		};
 
+		// everything that does not depend on the commodity, per stratum
+		std::vector<ve::fp_vector> stratum_life(pop_type_count);
+		std::vector<ve::fp_vector> stratum_everyday(pop_type_count);
+		std::vector<ve::fp_vector> stratum_luxury(pop_type_count);
 		for(const auto t : state.world.in_pop_type) {
-			auto scale_life = state.world.market_get_life_needs_scale(ids, t);
-			auto scale_everyday = state.world.market_get_everyday_needs_scale(ids, t);
-			auto scale_luxury = state.world.market_get_luxury_needs_scale(ids, t);
-
 			auto strata = t.get_strata();
+			stratum_life[t.id.index()] =
+				state.world.market_get_life_needs_scale(ids, t)
+				* life_mul[strata]
+				* state.defines.alice_lf_needs_scale;
+			stratum_everyday[t.id.index()] =
+				state.world.market_get_everyday_needs_scale(ids, t)
+				* everyday_mul[strata]
+				* state.defines.alice_ev_needs_scale
+				* invention_factor;
+			stratum_luxury[t.id.index()] =
+				state.world.market_get_luxury_needs_scale(ids, t)
+				* luxury_mul[strata]
+				* state.defines.alice_lx_needs_scale
+				* invention_factor;
+		}
 
-			for(uint32_t i = 1; i < total_commodities; ++i) {
-				dcon::commodity_id cid{ dcon::commodity_id::value_base_t(i) };
-
-				auto life_weight =
-					state.world.market_get_life_needs_weights(ids, cid);
-				auto everyday_weight =
-					state.world.market_get_everyday_needs_weights(ids, cid);
-				auto luxury_weight =
-					state.world.market_get_luxury_needs_weights(ids, cid);
-				auto base_life =
-					state.world.pop_type_get_life_needs(t, cid);
-				auto base_everyday =
-					state.world.pop_type_get_everyday_needs(t, cid);
-				auto base_luxury =
-					state.world.pop_type_get_luxury_needs(t, cid);
-
-				auto valid_good_mask = valid_need(state, nations, cid);
-
-				auto demand_life =
-					base_life
-					* scale_life
-					* life_mul[strata]
-					* life_weight
-					* state.defines.alice_lf_needs_scale;
-				auto demand_everyday =
-					base_everyday
-					* scale_everyday
-					* everyday_mul[strata]
-					* everyday_weight
-					* state.defines.alice_ev_needs_scale
-					* invention_factor;
-				auto demand_luxury =
-					base_luxury
-					* scale_luxury
-					* luxury_mul[strata]
-					* luxury_weight
-					* state.defines.alice_lx_needs_scale
-					* invention_factor;
-
-				demand_life = ve::select(valid_good_mask, demand_life, 0.f);
-				demand_everyday = ve::select(valid_good_mask, demand_everyday, 0.f);
-				demand_luxury = ve::select(valid_good_mask, demand_luxury, 0.f);
-
-				register_demand(state, ids, cid, demand_life, economy_reason::pop);
-				register_demand(state, ids, cid, demand_everyday, economy_reason::pop);
-				register_demand(state, ids, cid, demand_luxury, economy_reason::pop);
+		for(uint32_t i = 1; i < total_commodities; ++i) {
+			dcon::commodity_id cid{ dcon::commodity_id::value_base_t(i) };
+
+			ve::fp_vector demand_life{};
+			ve::fp_vector demand_everyday{};
+			ve::fp_vector demand_luxury{};
+
+			for(const auto t : state.world.in_pop_type) {
+				auto base_life = state.world.pop_type_get_life_needs(t, cid);
+				auto base_everyday = state.world.pop_type_get_everyday_needs(t, cid);
+				auto base_luxury = state.world.pop_type_get_luxury_needs(t, cid);
+				if(base_life > 0.f)
+					demand_life = demand_life + base_life * stratum_life[t.id.index()];
+				if(base_everyday > 0.f)
+					demand_everyday = demand_everyday + base_everyday * stratum_everyday[t.id.index()];
+				if(base_luxury > 0.f)
+					demand_luxury = demand_luxury + base_luxury * stratum_luxury[t.id.index()];
 			}
+
+			auto valid_good_mask = valid_need(state, nations, cid);
+
+			auto demand =
+				demand_life * state.world.market_get_life_needs_weights(ids, cid)
+				+ demand_everyday * state.world.market_get_everyday_needs_weights(ids, cid)
+				+ demand_luxury * state.world.market_get_luxury_needs_weights(ids, cid);
+
+			register_demand(state, ids, cid, ve::select(valid_good_mask, demand, 0.f), economy_reason::pop);
 		}
 	});
 }
@@ -3363,7 +3433,7 @@ std::vector<full_construction_state> estimate_private_investment_upgrade(sys::st
 }
 
 /* Returns number of initiated projects */
-std::vector<full_construction_state> estimate_private_investment_construct(sys::state& state, dcon::nation_id nid, bool craved, float est_private_const_spending) {
+std::vector<full_construction_state> estimate_private_investment_construct(sys::state& state, dcon::nation_id nid, bool craved, float est_private_const_spending, bool use_cached_scores) {
 	std::vector<full_construction_state> res;
 
 	auto n = dcon::fatten(state.world, nid);
@@ -3436,9 +3506,9 @@ std::vector<full_construction_state> estimate_private_investment_construct(sys::
 		// randomly try a valid (check coastal, unlocked, non existing) factory
 		desired_types.clear();
 		if(craved) {
-			ai::get_craved_factory_types(state, n, market, desired_types);
+			ai::get_craved_factory_types(state, n, market, desired_types, use_cached_scores);
 		} else {
-			ai::get_desired_factory_types(state, n, market, desired_types);
+			ai::get_desired_factory_types(state, n, market, desired_types, use_cached_scores);
 		}
 
 		if(desired_types.empty()) {
@@ -3688,6 +3758,39 @@ void run_private_investment(sys::state& state) {
 		
 }
 
+// money and tariffs that the trade in one commodity moves, per market
+struct trade_settlement {
+	std::vector<float> money;
+	std::vector<float> tariff;
+};
+
+void update_active_trade_routes(sys::state& state) {
+	auto& index = state.active_trade_routes;
+	auto const total_commodities = state.world.commodity_size();
+
+	index.by_commodity.resize(total_commodities);
+	concurrency::parallel_for(uint32_t(0), total_commodities, [&](uint32_t k) {
+		dcon::commodity_id cid{ dcon::commodity_id::value_base_t(k) };
+		auto& routes = index.by_commodity[k];
+		routes.clear();
+		state.world.for_each_trade_route([&](dcon::trade_route_id trade_route) {
+			if(state.world.trade_route_get_volume(trade_route, cid) != 0.f)
+				routes.push_back(trade_route);
+		});
+	});
+
+	index.route_is_active.assign(state.world.trade_route_size(), 0);
+	for(auto const& routes : index.by_commodity) {
+		for(auto trade_route : routes)
+			index.route_is_active[trade_route.index()] = 1;
+	}
+	index.any_commodity.clear();
+	state.world.for_each_trade_route([&](dcon::trade_route_id trade_route) {
+		if(index.route_is_active[trade_route.index()])
+			index.any_commodity.push_back(trade_route);
+	});
+}
+
 void daily_update(sys::state& state, bool presimulation, float presimulation_stage) {
 	float average_expected_savings = expected_savings_per_capita(state);
 
@@ -3814,8 +3917,42 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 
 	const float market_savings_target = 1'000'000.f;
 
+	// the commodities that can be traded at all, so that the kernel below only has to look at those
+	static std::vector<dcon::commodity_id> traded_commodities;
+	traded_commodities.clear();
+	for(auto c : state.world.in_commodity) {
+		if(!state.world.commodity_get_money_rgo(c) && !state.world.commodity_get_is_local(c)) {
+			traded_commodities.push_back(c);
+		}
+	}
+
 	// update trade volume based on potential profits right at the start
 	// we can't put it between demand and supply generation!
+	// it goes in two passes: the first one works out everything that depends only on the route, vectorized over routes, and
+	// the second one sweeps the traded commodities route by route. dcon stores prices and volumes commodity by commodity,
+	// so the sweep reads prices from a copy laid out market by market and transposes the volumes of a block of routes at a
+	// time into route major rows
+	auto const traded_count = uint32_t(traded_commodities.size());
+	static std::vector<float> traded_prices;
+	traded_prices.resize(size_t(state.world.market_size()) * traded_count);
+	concurrency::parallel_for(uint32_t(0), state.world.market_size(), [&](uint32_t m) {
+		dcon::market_id mid{ dcon::market_id::value_base_t(m) };
+		for(uint32_t k = 0; k < traded_count; ++k)
+			traded_prices[size_t(m) * traded_count + k] = state.world.market_get_price(mid, traded_commodities[k]);
+	});
+
+	auto route_merchant_cut = state.world.trade_route_make_vectorizable_float_buffer();
+	auto route_export_mult_A = state.world.trade_route_make_vectorizable_float_buffer();
+	auto route_export_mult_B = state.world.trade_route_make_vectorizable_float_buffer();
+	auto route_import_mult_A = state.world.trade_route_make_vectorizable_float_buffer();
+	auto route_import_mult_B = state.world.trade_route_make_vectorizable_float_buffer();
+	auto route_loss_mult = state.world.trade_route_make_vectorizable_float_buffer();
+	auto route_transport_cost = state.world.trade_route_make_vectorizable_float_buffer();
+	auto route_imports_aversion_A = state.world.trade_route_make_vectorizable_float_buffer();
+	auto route_imports_aversion_B = state.world.trade_route_make_vectorizable_float_buffer();
+	auto route_blocked = state.world.trade_route_make_vectorizable_float_buffer();
+	auto route_valid = state.world.trade_route_make_vectorizable_float_buffer();
+
 	state.world.execute_parallel_over_trade_route([&](auto trade_route) {
 
 		//concurrency::parallel_for(uint32_t(0), total_commodities, [&](uint32_t k) {
@@ -4030,87 +4167,141 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 				+ state.world.market_get_labor_price(B, labor::no_education)
 			);
 
-		for(auto c : state.world.in_commodity) {
-			if(state.world.commodity_get_money_rgo(c) || state.world.commodity_get_is_local(c)) {
-				continue;
-			}
-
-			//state.world.execute_serial_over_trade_route([&](auto trade_route) {
-			auto current_volume = state.world.trade_route_get_volume(trade_route, c);
-
-			auto absolute_volume = ve::abs(current_volume);
-			//auto sat = state.world.market_get_direct_demand_satisfaction(origin, c);
-
-
-
-			// effect of scale
-			// volume reduces transport costs
-			auto effect_of_scale = ve::max(0.1f, 1.f - absolute_volume * effect_of_transportation_scale);
-
-			auto price_A_export = ve_price(state, A, c) * (1.f + export_tariff_A);
-			auto price_B_export = ve_price(state, B, c) * (1.f + export_tariff_B);
-
-			auto price_A_import = ve_price(state, A, c) * (1.f - import_tariff_A) * trade_good_loss_mult;
-			auto price_B_import = ve_price(state, B, c) * (1.f - import_tariff_B) * trade_good_loss_mult;
-
-			auto current_profit_A_to_B = price_B_import - price_A_export * merchant_cut - transport_cost * effect_of_scale;
-			auto current_profit_B_to_A = price_A_import - price_B_export * merchant_cut - transport_cost * effect_of_scale;
-
-			auto none_is_profiable = (current_profit_A_to_B <= 0.f) && (current_profit_B_to_A <= 0.f);
+		auto route_is_valid = ve::apply([&](auto r) { return state.world.trade_route_is_valid(r); }, trade_route);
+		auto blocked =
+			at_war
+			|| A_joins_sphere_wide_embargo
+			|| B_joins_sphere_wide_embargo
+			|| trade_banned;
+
+		route_merchant_cut.set(trade_route, merchant_cut);
+		route_export_mult_A.set(trade_route, 1.f + export_tariff_A);
+		route_export_mult_B.set(trade_route, 1.f + export_tariff_B);
+		route_import_mult_A.set(trade_route, 1.f - import_tariff_A);
+		route_import_mult_B.set(trade_route, 1.f - import_tariff_B);
+		route_loss_mult.set(trade_route, trade_good_loss_mult);
+		route_transport_cost.set(trade_route, transport_cost);
+		route_imports_aversion_A.set(trade_route, imports_aversion_A);
+		route_imports_aversion_B.set(trade_route, imports_aversion_B);
+		route_blocked.set(trade_route, ve::select(blocked, ve::fp_vector{ 1.f }, ve::fp_vector{ 0.f }));
+		route_valid.set(trade_route, ve::select(route_is_valid, ve::fp_vector{ 1.f }, ve::fp_vector{ 0.f }));
+	});
 
-			auto max_change = 10.f + absolute_volume * 0.1f;
-			auto change = ve::select(current_profit_A_to_B > 0.f, current_profit_A_to_B / price_B_import, 0.f);
-			change = ve::select(current_profit_B_to_A > 0.f, -current_profit_B_to_A / price_A_import, change);
-			change = ve::min(ve::max(10.f * change, -max_change), max_change);
-			change = ve::select(none_is_profiable, -current_volume, change);
-			change = ve::select(
-				at_war
-				|| A_joins_sphere_wide_embargo
-				|| B_joins_sphere_wide_embargo
-				|| trade_banned,
-				-current_volume,
-				change
-			);
+	auto const route_count = state.world.trade_route_size();
+	concurrency::parallel_for(uint32_t(0), (route_count + trade_route_block - 1) / trade_route_block, [&](uint32_t block) {
+		static thread_local std::vector<float> volumes;
+		volumes.resize(size_t(trade_route_block) * traded_count);
+
+		auto const first = block * trade_route_block;
+		auto const last = std::min(route_count, first + trade_route_block);
+		for(uint32_t k = 0; k < traded_count; ++k) {
+			for(uint32_t r = first; r < last; ++r) {
+				dcon::trade_route_id route{ dcon::trade_route_id::value_base_t(r) };
+				volumes[size_t(r - first) * traded_count + k] = state.world.trade_route_get_volume(route, traded_commodities[k]);
+			}
+		}
 
-			// modifier for trade to slowly decay to create soft limit on transportation
-			// essentially, regularisation of trade weights, but can lead to weird effects
-			ve::fp_vector decay = 1.f;
-
-			// dirty, embarassing and disgusting hack
-			// to avoid trade generating too much demand
-			// on already expensive goods
-			// but it works well
-			decay = ve::select(
-				current_volume + change > 0.f,
-				decay * ve::min(1.f, market_savings_target * 0.001f / price_A_export / ve::max(0.01f, current_volume + change)) * imports_aversion_B,
-				decay * ve::min(1.f, market_savings_target * 0.001f / price_B_export / ve::max(0.01f, current_volume + change)) * imports_aversion_A
-			);
+		for(uint32_t r = first; r < last; ++r) {
+			dcon::trade_route_id route{ dcon::trade_route_id::value_base_t(r) };
+			auto row = volumes.data() + size_t(r - first) * traded_count;
+			if(route_valid.get(route) == 0.f) {
+				std::fill(row, row + traded_count, 0.0f);
+				continue;
+			}
 
-			state.world.trade_route_set_volume(trade_route, c, ve::select(ve::apply([&](auto r) { return state.world.trade_route_is_valid(r); }, trade_route), (current_volume + change) * decay, 0.0f));
+			auto A = state.world.trade_route_get_connected_markets(route, 0);
+			auto B = state.world.trade_route_get_connected_markets(route, 1);
+			auto prices_A = traded_prices.data() + size_t(A.index()) * traded_count;
+			auto prices_B = traded_prices.data() + size_t(B.index()) * traded_count;
+
+			auto const merchant_cut = route_merchant_cut.get(route);
+			auto const export_mult_A = route_export_mult_A.get(route);
+			auto const export_mult_B = route_export_mult_B.get(route);
+			auto const import_mult_A = route_import_mult_A.get(route);
+			auto const import_mult_B = route_import_mult_B.get(route);
+			auto const trade_good_loss_mult = route_loss_mult.get(route);
+			auto const transport_cost = route_transport_cost.get(route);
+			auto const imports_aversion_A = route_imports_aversion_A.get(route);
+			auto const imports_aversion_B = route_imports_aversion_B.get(route);
+			auto const blocked = route_blocked.get(route) != 0.f;
+
+			for(uint32_t k = 0; k < traded_count; ++k) {
+				auto current_volume = row[k];
+				auto absolute_volume = std::abs(current_volume);
+
+				// effect of scale
+				// volume reduces transport costs
+				auto effect_of_scale = std::max(0.1f, 1.f - absolute_volume * effect_of_transportation_scale);
+
+				auto price_A_export = prices_A[k] * export_mult_A;
+				auto price_B_export = prices_B[k] * export_mult_B;
+
+				auto price_A_import = prices_A[k] * import_mult_A * trade_good_loss_mult;
+				auto price_B_import = prices_B[k] * import_mult_B * trade_good_loss_mult;
+
+				auto current_profit_A_to_B = price_B_import - price_A_export * merchant_cut - transport_cost * effect_of_scale;
+				auto current_profit_B_to_A = price_A_import - price_B_export * merchant_cut - transport_cost * effect_of_scale;
+
+				auto none_is_profiable = (current_profit_A_to_B <= 0.f) && (current_profit_B_to_A <= 0.f);
+
+				// both directions are computed and then selected, so that the loop stays branch free
+				auto max_change = 10.f + absolute_volume * 0.1f;
+				auto change_to_B = current_profit_A_to_B / price_B_import;
+				auto change_to_A = -current_profit_B_to_A / price_A_import;
+				auto change = current_profit_A_to_B > 0.f ? change_to_B : 0.f;
+				change = current_profit_B_to_A > 0.f ? change_to_A : change;
+				change = std::min(std::max(10.f * change, -max_change), max_change);
+				change = none_is_profiable || blocked ? -current_volume : change;
+
+				// modifier for trade to slowly decay to create soft limit on transportation
+				// essentially, regularisation of trade weights, but can lead to weird effects
+
+				// dirty, embarassing and disgusting hack
+				// to avoid trade generating too much demand
+				// on already expensive goods
+				// but it works well
+				auto new_volume = current_volume + change;
+				auto decay_to_B = std::min(1.f, market_savings_target * 0.001f / price_A_export / std::max(0.01f, new_volume)) * imports_aversion_B;
+				auto decay_to_A = std::min(1.f, market_savings_target * 0.001f / price_B_export / std::max(0.01f, new_volume)) * imports_aversion_A;
+				auto decay = new_volume > 0.f ? decay_to_B : decay_to_A;
+
+				row[k] = new_volume * decay;
+			}
+		}
 
-			ve::apply([&](auto route) {
-				assert(std::isfinite(state.world.trade_route_get_volume(route, c)));
-			}, trade_route);
+		for(uint32_t k = 0; k < traded_count; ++k) {
+			for(uint32_t r = first; r < last; ++r) {
+				dcon::trade_route_id route{ dcon::trade_route_id::value_base_t(r) };
+				auto volume = volumes[size_t(r - first) * traded_count + k];
+				assert(std::isfinite(volume));
+				state.world.trade_route_set_volume(route, traded_commodities[k], volume);
+			}
 		}
 	});
 
 	sanity_check(state);
 
+	// from here on, routes without any volume of a commodity have no effect on it, so they are skipped
+	update_active_trade_routes(state);
+
 	// limit trade with local throughput
 
 	concurrency::parallel_for(uint32_t(0), total_commodities, [&](uint32_t k) {
 		dcon::commodity_id commodity{ dcon::commodity_id::value_base_t(k) };
-		state.world.for_each_market([&](auto market) {
-			auto satisfied_local_transport = state.world.market_get_labor_demand_satisfaction(market, labor::no_education);
-			state.world.market_for_each_trade_route(market, [&](auto trade_route) {
-				state.world.trade_route_set_volume(
-					trade_route,
-					commodity,
-					state.world.trade_route_get_volume(trade_route, commodity)
-					* satisfied_local_transport
-				);
-			});
-		});
+		for(auto trade_route : state.active_trade_routes.by_commodity[k]) {
+			auto A = state.world.trade_route_get_connected_markets(trade_route, 0);
+			auto B = state.world.trade_route_get_connected_markets(trade_route, 1);
+			// the market with the lower index is applied first, as when this went over the routes of each market in turn
+			auto first = A.index() < B.index() ? A : B;
+			auto second = A.index() < B.index() ? B : A;
+			state.world.trade_route_set_volume(
+				trade_route,
+				commodity,
+				state.world.trade_route_get_volume(trade_route, commodity)
+				* state.world.market_get_labor_demand_satisfaction(first, labor::no_education)
+				* state.world.market_get_labor_demand_satisfaction(second, labor::no_education)
+			);
+		}
 	});
 
 	sanity_check(state);
@@ -4131,6 +4322,8 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 		});
 	});
 
+	update_factories_consumption(state);
+
 	state.world.execute_parallel_over_market([&](auto markets) {
 		// reset gdp
 		state.world.market_set_gdp(markets, 0.f);
@@ -4412,8 +4605,7 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 			[&](
 				dcon::state_instance_id s,
 				dcon::market_id m,
-				dcon::nation_id n,
-				float mob_impact
+				dcon::nation_id n
 				) {
 					auto capital = state.world.state_instance_get_capital(s);
 					province::for_each_province_in_state_instance(state, s, [&](auto p) {
@@ -4422,23 +4614,14 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 						// update local rgo consumption
 
 						for(auto f : state.world.province_get_factory_location(p)) {
-							update_single_factory_consumption(
-								state,
-								f.get_factory(),
-								p,
-								s,
-								m,
-								n,
-								mob_impact,
-								state.world.province_get_nation_from_province_control(p) != n // is occupied
-							);
+							register_factory_demand(state, f.get_factory(), m);
 						}
 						update_rgo_consumption(
 							state,
 							p, m
 						);
 					});
-				}, states, markets, nations, mobilization_impact
+				}, states, markets, nations
 		);
 	});
 
@@ -4570,7 +4753,7 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 			return;
 		}
 
-		state.world.for_each_trade_route([&](auto trade_route) {
+		for(auto trade_route : state.active_trade_routes.by_commodity[k]) {
 			auto current_volume = state.world.trade_route_get_volume(trade_route, cid);
 			auto origin =
 				current_volume > 0.f
@@ -4597,12 +4780,12 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 			auto n_target = state.world.state_instance_get_nation_from_state_ownership(s_target);
 
 			register_demand(state, origin, cid, absolute_volume, economy_reason::trade);
-		});
+		}
 	});
 
 	// register trade demand on transportation labor:
 	// money are paid during calculation of trade route profits and actual movement of goods
-	state.world.for_each_trade_route([&](auto trade_route) {
+	for(auto trade_route : state.active_trade_routes.any_commodity) {
 		auto A = state.world.trade_route_get_connected_markets(trade_route, 0);
 		auto B = state.world.trade_route_get_connected_markets(trade_route, 1);
 
@@ -4622,7 +4805,7 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 
 		state.world.market_get_labor_demand(A, labor::no_education) += total_demanded_labor;
 		state.world.market_get_labor_demand(B, labor::no_education) += total_demanded_labor;
-	});
+	}
 
 	// register demand on local transportation/accounting due to trade
 	// all trade generates uneducated labor demand for goods transport locally
@@ -4637,14 +4820,12 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 		state.world.for_each_commodity([&](auto commodity) {
 			state.world.market_for_each_trade_route(market, [&](auto trade_route) {
 				auto current_volume = state.world.trade_route_get_volume(trade_route, commodity);
+				if(current_volume == 0.f)
+					return;
 				auto origin =
 					current_volume > 0.f
 					? state.world.trade_route_get_connected_markets(trade_route, 0)
 					: state.world.trade_route_get_connected_markets(trade_route, 1);
-				auto target =
-					current_volume <= 0.f
-					? state.world.trade_route_get_connected_markets(trade_route, 0)
-					: state.world.trade_route_get_connected_markets(trade_route, 1);
 
 				auto sat = state.world.market_get_direct_demand_satisfaction(origin, commodity);
 				base_cargo_transport_demand += std::abs(current_volume * sat);
@@ -5136,34 +5317,45 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 		});
 	}
 
-	// we can't handle each trade good separately: they do influence common markets
-	// todo: split the logic so some part of it could be done in parallel
-	// 
 	// register trade supply
-	//concurrency::parallel_for(uint32_t(1), total_commodities, [&](uint32_t k)
-	for(uint32_t k = 0; k < total_commodities; k++) {
+	// each commodity is settled by one task: exports, imports and stockpiles of the commodity itself are written directly,
+	// while the money and tariffs (which all commodities share) are collected per market and combined afterwards
+	static std::vector<trade_settlement> settlements;
+	settlements.resize(total_commodities);
+	concurrency::parallel_for(uint32_t(0), total_commodities, [&](uint32_t k) {
 		dcon::commodity_id cid{ dcon::commodity_id::value_base_t(k) };
+		auto& settlement = settlements[k];
+		settlement.money.assign(state.world.market_size(), 0.f);
+		settlement.tariff.assign(state.world.market_size(), 0.f);
 
 		if(state.world.commodity_get_money_rgo(cid)) {
-			continue;
+			return;
 		}
 
-		state.world.for_each_trade_route([&](auto trade_route) {
+		for(auto trade_route : state.active_trade_routes.by_commodity[k]) {
 			trade_and_tariff route_data = explain_trade_route_commodity(state, trade_route, cid);
 
 			state.world.market_get_export(route_data.origin, cid) += route_data.amount_origin;
 			state.world.market_get_import(route_data.target, cid) += route_data.amount_target;
-			state.world.market_get_stockpile(route_data.origin, economy::money) += route_data.amount_origin * route_data.payment_received_per_unit;
-			state.world.market_get_stockpile(route_data.target, economy::money) -= route_data.amount_origin * route_data.payment_per_unit;
-			state.world.market_get_tariff_collected(route_data.origin) += route_data.tariff_origin;
-			state.world.market_get_tariff_collected(route_data.target) += route_data.tariff_target;
+			settlement.money[route_data.origin.index()] += route_data.amount_origin * route_data.payment_received_per_unit;
+			settlement.money[route_data.target.index()] -= route_data.amount_origin * route_data.payment_per_unit;
+			settlement.tariff[route_data.origin.index()] += route_data.tariff_origin;
+			settlement.tariff[route_data.target.index()] += route_data.tariff_target;
 			state.world.market_get_stockpile(route_data.target, cid) += route_data.amount_target;
 
 			assert(std::isfinite(state.world.market_get_export(route_data.origin, cid)));
 			assert(std::isfinite(state.world.market_get_import(route_data.target, cid)));
+		}
+	});
+
+	// combined in commodity order, so the totals don't depend on how the commodities were split between the threads
+	for(uint32_t k = 0; k < total_commodities; k++) {
+		auto const& settlement = settlements[k];
+		state.world.for_each_market([&](dcon::market_id m) {
+			state.world.market_get_stockpile(m, economy::money) += settlement.money[m.index()];
+			state.world.market_get_tariff_collected(m) += settlement.tariff[m.index()];
 		});
 	}
-	//});
 
 	// we bought something: register supply from stockpiles:
 
@@ -5384,6 +5576,8 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 	float total_rgo_owner_income = 0.f;
 #endif
 
+	update_factories_production(state);
+
 	for(auto n : state.world.in_nation) {
 		auto const min_wage_factor = pop_min_wage_factor(state, n);
 
@@ -5394,12 +5588,10 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 
 			// factories production
 			for(auto f : state.world.province_get_factory_location(p.get_province())) {
-				update_single_factory_production(
-					state,
-					f.get_factory(),
-					market,
-					n
-				);
+				auto production = f.get_factory().get_actual_production();
+				if(production > 0) {
+					register_domestic_supply(state, market, f.get_factory().get_building_type().get_output(), production, economy_reason::factory);
+				}
 			}
 
 			// rgo production
@@ -5996,33 +6188,6 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 
 	sanity_check(state);
 
-	if(state.cheat_data.ecodump) {
-		float accumulator[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-
-		state.world.for_each_commodity([&](dcon::commodity_id c) {
-			float states_count = 0.f;
-			float total_price = 0.f;
-			float total_production = 0.f;
-			float total_demand = 0.f;
-
-			state.world.for_each_market([&](auto id) {
-				states_count++;
-				total_price += state.world.market_get_price(id, c);
-				total_production += state.world.market_get_supply(id, c);
-				total_demand += state.world.market_get_demand(id, c);
-			});
-
-			state.cheat_data.prices_dump_buffer += std::to_string(total_price / states_count) + ",";
-			state.cheat_data.supply_dump_buffer += std::to_string(total_production) + ",";
-			state.cheat_data.demand_dump_buffer += std::to_string(total_demand) + ",";
-		});
-
-		state.cheat_data.prices_dump_buffer += "\n";
-		state.cheat_data.supply_dump_buffer += "\n";
-		state.cheat_data.demand_dump_buffer += "\n";
-	}
-
-
 	/*
 	DIPLOMATIC EXPENSES
 	*/
@@ -6128,90 +6293,14 @@ void daily_update(sys::state& state, bool presimulation, float presimulation_sta
 	resolve_constructions(state);
 
 	if(!presimulation) {
+		update_factory_type_scores(state);
 		run_private_investment(state);
 	}
 
 	sanity_check(state);
 
-	//write gdp and total savings to file
 	if(state.cheat_data.ecodump) {
-		for(auto si : state.world.in_state_instance) {
-			auto market = si.get_market_from_local_market();
-			auto nation = si.get_nation_from_state_ownership();
-
-			auto life_costs =
-				state.world.market_get_life_needs_costs(
-					market, state.culture_definitions.primary_factory_worker)
-				+ state.world.market_get_everyday_needs_costs(
-					market, state.culture_definitions.primary_factory_worker)
-				+ state.world.market_get_luxury_needs_costs(
-					market, state.culture_definitions.primary_factory_worker);
-
-			auto tag = nations::int_to_tag(
-				state.world.national_identity_get_identifying_int(
-					state.world.nation_get_identity_from_identity_holder(nation)
-				)
-			);
-			auto state_name = text::produce_simple_string(
-				state,
-				state.world.state_definition_get_name(
-					si.get_definition()
-				)
-			);
-			auto name = text::produce_simple_string(state, text::get_name(state, nation));
-			state.cheat_data.national_economy_dump_buffer +=
-				tag + ","
-				+ name + ","
-				+ state_name + ","
-				+ std::to_string(state.world.market_get_gdp(market)) + ","
-				+ std::to_string(life_costs) + ","
-				+ std::to_string(state.world.state_instance_get_demographics(si, demographics::total)) + ","
-				+ std::to_string(state.current_date.value) + "\n";
-		}
-
-		float total_savings_pops[20] = { };
-
-		for(int i = 0; i < 20; i++) {
-			total_savings_pops[i] = 0.f;
-		}
-		state.world.for_each_pop([&](auto pop) {
-			total_savings_pops[state.world.pop_get_poptype(pop).id.index()] += state.world.pop_get_savings(pop);
-		});
-
-		float total_savings_markets = 0.f;
-		state.world.for_each_market([&](auto market) {
-			total_savings_markets += state.world.market_get_stockpile(market, economy::money);
-		});
-
-		float total_savings_nations = 0.f;
-		float total_investment_pool = 0.f;
-		state.world.for_each_nation([&](auto nation) {
-			total_savings_nations += state.world.nation_get_stockpiles(nation, economy::money);
-			total_investment_pool += state.world.nation_get_private_investment(nation);
-		});
-
-		if(state.cheat_data.savings_buffer.size() == 0) {
-			state.world.for_each_pop_type([&](auto pop_type) {
-				state.cheat_data.savings_buffer += text::produce_simple_string(
-					state,
-					state.world.pop_type_get_name(pop_type)
-				);
-				state.cheat_data.savings_buffer += ";";
-			});
-
-			state.cheat_data.savings_buffer += "markets;nations;investments\n";
-		} else {
-			state.world.for_each_pop_type([&](auto pop_type) {
-				state.cheat_data.savings_buffer += std::to_string(total_savings_pops[pop_type.index()]);
-				state.cheat_data.savings_buffer += ";";
-			});
-			state.cheat_data.savings_buffer += std::to_string(total_savings_markets);
-			state.cheat_data.savings_buffer += ";";
-			state.cheat_data.savings_buffer += std::to_string(total_savings_nations);
-			state.cheat_data.savings_buffer += ";";
-			state.cheat_data.savings_buffer += std::to_string(total_investment_pool);
-			state.cheat_data.savings_buffer += "\n";
-		}
+		economy_telemetry::record_day(state);
 	}
 
 	sanity_check(state);
@@ -6708,6 +6797,8 @@ std::vector<trade_breakdown_item> explain_national_tariff(sys::state& state, dco
 }
 
 float estimate_gold_income(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->gold_income;
 	auto amount = 0.f;
 	for(auto poid : state.world.nation_get_province_ownership_as_nation(n)) {
 		auto prov = poid.get_province();
@@ -6724,6 +6815,8 @@ float estimate_gold_income(sys::state& state, dcon::nation_id n) {
 }
 
 float estimate_tariff_import_income(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->tariff_import_income;
 	float result = 0.f;
 	state.world.for_each_commodity([&](dcon::commodity_id cid) {
 		state.world.nation_for_each_state_ownership(n, [&](auto sid) {
@@ -6745,6 +6838,8 @@ float estimate_tariff_import_income(sys::state& state, dcon::nation_id n) {
 }
 
 float estimate_tariff_export_income(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->tariff_export_income;
 	float result = 0.f;
 	state.world.for_each_commodity([&](dcon::commodity_id cid) {
 		state.world.nation_for_each_state_ownership(n, [&](auto sid) {
@@ -6766,6 +6861,8 @@ float estimate_tariff_export_income(sys::state& state, dcon::nation_id n) {
 }
 
 float estimate_social_spending(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->social_spending;
 	auto total = 0.f;
 	auto const p_level = state.world.nation_get_modifier_values(n, sys::national_mod_offsets::pension_level);
 	auto const unemp_level = state.world.nation_get_modifier_values(n, sys::national_mod_offsets::unemployment_benefit);
@@ -6799,6 +6896,8 @@ float estimate_social_spending(sys::state& state, dcon::nation_id n) {
 }
 
 float estimate_pop_payouts_by_income_type(sys::state& state, dcon::nation_id n, culture::income_type in) {
+	if(auto p = cached_budget_projection(state, n); p && uint8_t(in) < std::size(p->pop_payouts))
+		return p->pop_payouts[uint8_t(in)];
 	auto total = 0.f;
 	state.world.nation_for_each_state_ownership(n, [&](auto soid) {
 		auto local_state = state.world.state_ownership_get_state(soid);
@@ -6834,6 +6933,8 @@ float estimate_subsidy_spending(sys::state& state, dcon::nation_id n) {
 }
 
 float estimate_war_subsidies_income(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->war_subsidies_income;
 	float total = 0.0f;
 
 	for(auto uni : state.world.nation_get_unilateral_relationship_as_target(n)) {
@@ -6844,6 +6945,8 @@ float estimate_war_subsidies_income(sys::state& state, dcon::nation_id n) {
 	return total;
 }
 float estimate_reparations_income(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->reparations_income;
 	float total = 0.0f;
 	for(auto uni : state.world.nation_get_unilateral_relationship_as_target(n)) {
 		if(uni.get_reparations() && state.current_date < uni.get_source().get_reparations_until()) {
@@ -6860,6 +6963,8 @@ float estimate_reparations_income(sys::state& state, dcon::nation_id n) {
 }
 
 float estimate_war_subsidies_spending(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->war_subsidies_spending;
 	float total = 0.0f;
 
 	for(auto uni : state.world.nation_get_unilateral_relationship_as_source(n)) {
@@ -6872,6 +6977,8 @@ float estimate_war_subsidies_spending(sys::state& state, dcon::nation_id n) {
 }
 
 float estimate_reparations_spending(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->reparations_spending;
 	float total = 0.0f;
 	if(state.current_date < state.world.nation_get_reparations_until(n)) {
 		for(auto uni : state.world.nation_get_unilateral_relationship_as_source(n)) {
@@ -6910,6 +7017,8 @@ float estimate_diplomatic_expenses(sys::state& state, dcon::nation_id n) {
 
 
 float estimate_max_domestic_investment(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->max_domestic_investment;
 	auto total = 0.f;
 	state.world.nation_for_each_state_ownership(n, [&](auto soid) {
 		auto local_state = state.world.state_ownership_get_state(soid);
@@ -6944,6 +7053,8 @@ float estimate_current_domestic_investment(sys::state& state, dcon::nation_id n)
 }
 
 float estimate_land_spending(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->land_spending;
 	float total = 0.0f;
 	uint32_t total_commodities = state.world.commodity_size();
 	state.world.nation_for_each_state_ownership(n, [&](auto soid) {
@@ -6961,6 +7072,8 @@ float estimate_land_spending(sys::state& state, dcon::nation_id n) {
 }
 
 float estimate_naval_spending(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->naval_spending;
 	float total = 0.0f;
 	uint32_t total_commodities = state.world.commodity_size();
 	state.world.nation_for_each_state_ownership(n, [&](auto soid) {
@@ -6985,6 +7098,8 @@ float estimate_war_subsidies(sys::state& state, dcon::nation_fat_id target, dcon
 }
 
 float estimate_subject_payments_paid(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->subject_payments_paid;
 	auto tax = explain_tax_income(state, n);
 	auto const tax_eff = nations::tax_efficiency(state, n);
 	auto collected_tax = tax.mid + tax.poor + tax.rich;
@@ -7007,24 +7122,31 @@ float estimate_subject_payments_paid(sys::state& state, dcon::nation_id n) {
 	return 0;
 }
 
+// what the overlord of n receives from it, before the payment is limited by the treasury of n
+float subject_payment_to_overlord(sys::state& state, dcon::nation_id n) {
+	auto tax = explain_tax_income(state, n);
+	auto const collected_tax = tax.poor + tax.mid + tax.rich;
+	auto transferamt = collected_tax;
+
+	if(state.world.nation_get_is_substate(n)) {
+		transferamt *= state.defines.alice_substate_subject_money_transfer / 100.f;
+	} else {
+		transferamt *= state.defines.alice_puppet_subject_money_transfer / 100.f;
+	}
+
+	return transferamt;
+}
+
 float estimate_subject_payments_received(sys::state& state, dcon::nation_id o) {
+	if(auto p = cached_budget_projection(state, o))
+		return p->subject_payments_received;
 	auto res = 0.0f;
 	for(auto n : state.world.in_nation) {
 		auto rel = state.world.nation_get_overlord_as_subject(n);
 		auto overlord = state.world.overlord_get_ruler(rel);
 
 		if(overlord == o) {
-			auto tax = explain_tax_income(state, n);
-			auto const collected_tax = tax.poor + tax.mid + tax.rich;
-			auto transferamt = collected_tax;
-
-			if(state.world.nation_get_is_substate(n)) {
-				transferamt *= state.defines.alice_substate_subject_money_transfer / 100.f;
-			} else {
-				transferamt *= state.defines.alice_puppet_subject_money_transfer / 100.f;
-			}
-
-			res += transferamt;
+			res += subject_payment_to_overlord(state, n);
 		}
 	}
 
@@ -7494,11 +7616,154 @@ void resolve_constructions(sys::state& state) {
  * return value is passed directly into text::fp_currency{} without adulteration.
  */
 float estimate_daily_income(sys::state& state, dcon::nation_id n) {
+	if(auto p = cached_budget_projection(state, n))
+		return p->daily_income;
 	auto tax = explain_tax_income(state, n);
 	auto const tax_eff = nations::tax_efficiency(state, n);
 	return tax.mid + tax.poor + tax.rich;
 }
 
+std::optional<budget_projection> cached_budget_projection(sys::state& state, dcon::nation_id n) {
+	auto& cache = state.budget_projections;
+	if(!cache.ready.load(std::memory_order::acquire))
+		return std::nullopt;
+	std::lock_guard lock{ cache.lock };
+	if(uint32_t(n.index()) < cache.entries.size() && cache.entries[n.index()].valid)
+		return cache.entries[n.index()];
+	return std::nullopt;
+}
+
+static budget_projection compute_budget_projection(sys::state& state, dcon::nation_id n) {
+	budget_projection r;
+	r.daily_income = estimate_daily_income(state, n);
+	r.gold_income = estimate_gold_income(state, n);
+	r.tariff_import_income = estimate_tariff_import_income(state, n);
+	r.tariff_export_income = estimate_tariff_export_income(state, n);
+	r.social_spending = estimate_social_spending(state, n);
+	for(uint8_t i = 0; i < std::size(r.pop_payouts); i++)
+		r.pop_payouts[i] = estimate_pop_payouts_by_income_type(state, n, culture::income_type(i));
+	r.max_domestic_investment = estimate_max_domestic_investment(state, n);
+	r.land_spending = estimate_land_spending(state, n);
+	r.naval_spending = estimate_naval_spending(state, n);
+	r.overseas_penalty_spending = estimate_overseas_penalty_spending(state, n);
+	r.stockpile_filling_spending = estimate_stockpile_filling_spending(state, n);
+	r.construction_spending = estimate_construction_spending(state, n);
+	r.private_construction_spending = estimate_private_construction_spendings(state, n);
+	r.war_subsidies_income = estimate_war_subsidies_income(state, n);
+	r.war_subsidies_spending = estimate_war_subsidies_spending(state, n);
+	r.reparations_income = estimate_reparations_income(state, n);
+	r.reparations_spending = estimate_reparations_spending(state, n);
+	r.subject_payments_paid = estimate_subject_payments_paid(state, n);
+	// filled in afterwards from the payments of the subjects, which saves a pass over every nation per nation
+	r.subject_payments_received = 0.0f;
+	r.valid = true;
+	return r;
+}
+
+void update_budget_projections(sys::state& state) {
+	auto nations = state.world.nation_size();
+	// entries are computed while the old ones are not ready, so that the estimates are computed directly
+	invalidate_budget_projections(state);
+
+	std::vector<budget_projection> result(nations);
+	std::vector<float> payment_to_overlord(nations, 0.0f);
+	concurrency::parallel_for(uint32_t(0), nations, [&](uint32_t i) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
+		if(!state.world.nation_is_valid(n))
+			return;
+		result[i] = compute_budget_projection(state, n);
+		if(state.world.overlord_get_ruler(state.world.nation_get_overlord_as_subject(n)))
+			payment_to_overlord[i] = subject_payment_to_overlord(state, n);
+	});
+	// in nation order, as estimate_subject_payments_received adds them up
+	for(uint32_t i = 0; i < nations; i++) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
+		if(!state.world.nation_is_valid(n))
+			continue;
+		auto overlord = state.world.overlord_get_ruler(state.world.nation_get_overlord_as_subject(n));
+		if(overlord && result[overlord.index()].valid)
+			result[overlord.index()].subject_payments_received += payment_to_overlord[i];
+	}
+
+	{
+		std::lock_guard lock{ state.budget_projections.lock };
+		state.budget_projections.entries = std::move(result);
+	}
+	state.budget_projections.ready.store(true, std::memory_order::release);
+}
+
+void invalidate_budget_projections(sys::state& state) {
+	state.budget_projections.ready.store(false, std::memory_order::release);
+}
+
+static factory_type_score compute_factory_type_score(sys::state& state, dcon::nation_id n, dcon::market_id m, dcon::factory_type_id type) {
+	factory_type_score r;
+	r.build_cost = factory_type_build_cost(state, n, m, type);
+	r.output_cost = factory_type_output_cost(state, n, m, type);
+	r.input_cost = factory_type_input_cost(state, n, m, type);
+	r.lacking_output = state.world.market_get_demand_satisfaction(m, state.world.factory_type_get_output(type)) < 0.98f;
+
+	auto& inputs = state.world.factory_type_get_inputs(type);
+	for(uint32_t i = 0; i < commodity_set::set_size; ++i) {
+		if(inputs.commodity_type[i]) {
+			if(state.world.market_get_demand_satisfaction(m, inputs.commodity_type[i]) < 0.5f)
+				r.lacking_input = true;
+		} else {
+			break;
+		}
+	}
+	auto& constr_cost = state.world.factory_type_get_construction_costs(type);
+	for(uint32_t i = 0; i < commodity_set::set_size; ++i) {
+		if(constr_cost.commodity_type[i]) {
+			if(state.world.market_get_demand_satisfaction(m, constr_cost.commodity_type[i]) < 0.1f)
+				r.lacking_construction = true;
+		} else {
+			break;
+		}
+	}
+	return r;
+}
+
+factory_type_score score_factory_type(sys::state& state, dcon::nation_id n, dcon::market_id m, dcon::factory_type_id type, bool use_cache) {
+	auto const types = state.world.factory_type_size();
+	auto const index = size_t(m.index()) * types + type.index();
+	if(use_cache
+		&& state.factory_type_scores_valid
+		&& index < state.factory_type_scores.size()
+		&& state.world.state_instance_get_nation_from_state_ownership(state.world.market_get_zone_from_local_market(m)) == n) {
+		return state.factory_type_scores[index];
+	}
+	return compute_factory_type_score(state, n, m, type);
+}
+
+void update_factory_type_scores(sys::state& state) {
+	auto const markets = state.world.market_size();
+	auto const types = state.world.factory_type_size();
+
+	state.factory_type_scores_valid = false;
+	state.factory_type_scores.resize(size_t(markets) * types);
+
+	// every market only writes its own row
+	concurrency::parallel_for(uint32_t(0), markets, [&](uint32_t i) {
+		dcon::market_id m{ dcon::market_id::value_base_t(i) };
+		if(!state.world.market_is_valid(m))
+			return;
+		auto n = state.world.state_instance_get_nation_from_state_ownership(state.world.market_get_zone_from_local_market(m));
+		if(!n)
+			return;
+		for(uint32_t j = 0; j < types; j++) {
+			dcon::factory_type_id type{ dcon::factory_type_id::value_base_t(j) };
+			state.factory_type_scores[size_t(i) * types + j] = compute_factory_type_score(state, n, m, type);
+		}
+	});
+
+	state.factory_type_scores_valid = true;
+}
+
+void invalidate_factory_type_scores(sys::state& state) {
+	state.factory_type_scores_valid = false;
+}
+
 void try_add_factory_to_state(sys::state& state, dcon::state_instance_id s, dcon::factory_type_id t) {
 	auto n = state.world.state_instance_get_nation_from_state_ownership(s);
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+#include <optional>
 #include "container_types.hpp"
 #include "dcon_generated.hpp"
 #include "commands.hpp"
@@ -167,6 +170,7 @@ inline constexpr float merchant_cut_foreign = 0.05f;
 inline constexpr float merchant_cut_domestic = 0.001f;
 inline constexpr float effect_of_transportation_scale = 0.0005f;
 inline constexpr float trade_distance_covered_by_pair_of_workers_per_unit_of_good = 100.f;
+inline constexpr uint32_t trade_route_block = 64; // routes whose volumes the trade volume update transposes at a time
 
 // greed drives incomes of corresponding pops up
 // while making life worse on average
@@ -345,6 +349,15 @@ struct trade_and_tariff {
 };
 
 trade_and_tariff explain_trade_route_commodity(sys::state& state, dcon::trade_route_id trade_route, dcon::commodity_id cid);
+
+// the routes that carry a non-zero volume of each commodity (and of any commodity), in route order
+// rebuilt by daily_update after the volumes are updated, and only valid until the next update of the volumes
+struct active_trade_routes {
+	std::vector<std::vector<dcon::trade_route_id>> by_commodity;
+	std::vector<dcon::trade_route_id> any_commodity;
+	std::vector<uint8_t> route_is_active;
+};
+void update_active_trade_routes(sys::state& state);
 struct trade_breakdown_item {
 	dcon::nation_id trade_partner;
 	dcon::commodity_id commodity;
@@ -393,7 +406,8 @@ struct full_construction_province {
 };
 
 std::vector<full_construction_state> estimate_private_investment_upgrade(sys::state& state, dcon::nation_id nid, float est_private_const_spending);
-std::vector<full_construction_state> estimate_private_investment_construct(sys::state& state, dcon::nation_id nid, bool craved, float est_private_const_spending);
+// the ui passes use_cached_scores = false, see factory_type_score
+std::vector<full_construction_state> estimate_private_investment_construct(sys::state& state, dcon::nation_id nid, bool craved, float est_private_const_spending, bool use_cached_scores = true);
 std::vector<full_construction_province> estimate_private_investment_province(sys::state& state, dcon::nation_id nid, float est_private_const_spending);
 
 // NOTE: used to estimate how much you will pay if you were to subsidize a particular nation,
@@ -405,6 +419,60 @@ float estimate_subject_payments_received(sys::state& state, dcon::nation_id o);
 
 float estimate_daily_income(sys::state& state, dcon::nation_id n);
 
+// copies of the budget estimates of each nation, rebuilt in one pass at the end of every tick and after every batch of
+// commands, so that the budget window, the ledger and the tooltips do not redo the work every frame. The estimate_*
+// functions read from here while the copies are ready and compute the value directly otherwise. The copies stop being
+// ready when the tick or a batch of commands starts, so the simulation and the commands never read a copy
+struct budget_projection {
+	float daily_income = 0.0f;
+	float gold_income = 0.0f;
+	float tariff_import_income = 0.0f;
+	float tariff_export_income = 0.0f;
+	float social_spending = 0.0f;
+	float pop_payouts[5] = { 0.0f }; // indexed by culture::income_type
+	float max_domestic_investment = 0.0f;
+	float land_spending = 0.0f;
+	float naval_spending = 0.0f;
+	float overseas_penalty_spending = 0.0f;
+	float stockpile_filling_spending = 0.0f;
+	float construction_spending = 0.0f;
+	float private_construction_spending = 0.0f;
+	float war_subsidies_income = 0.0f;
+	float war_subsidies_spending = 0.0f;
+	float reparations_income = 0.0f;
+	float reparations_spending = 0.0f;
+	float subject_payments_paid = 0.0f;
+	float subject_payments_received = 0.0f;
+	bool valid = false;
+};
+struct budget_projection_cache {
+	std::vector<budget_projection> entries; // by nation
+	std::mutex lock; // the ui thread copies entries out while the game thread replaces them
+	std::atomic<bool> ready = false; // checked before taking the lock, so that the tick never waits on it
+};
+std::optional<budget_projection> cached_budget_projection(sys::state& state, dcon::nation_id n); // empty when not ready
+// game thread
+void update_budget_projections(sys::state& state);
+void invalidate_budget_projections(sys::state& state);
+
+// what the selectors of factory types to build (private investment, the ai and the build factory window) need to know
+// about a factory type in the market of a state. Every (market, factory type) pair is scored in one parallel pass right
+// before private investment runs; score_factory_type reads from there until the start of the next tick, as long as the
+// nation asking still owns the state, and computes the values directly otherwise. The buffer is rewritten by the game
+// thread during the tick, so the ui (the build factory window and the top bar estimates) must not read it and passes
+// use_cache = false
+struct factory_type_score {
+	float build_cost = 0.0f;
+	float output_cost = 0.0f;
+	float input_cost = 0.0f;
+	bool lacking_input = false; // some input is below half satisfaction
+	bool lacking_output = false; // the output is below 98% satisfaction
+	bool lacking_construction = false; // some construction good is below 10% satisfaction
+};
+factory_type_score score_factory_type(sys::state& state, dcon::nation_id n, dcon::market_id m, dcon::factory_type_id type, bool use_cache = true);
+void update_factory_type_scores(sys::state& state);
+void invalidate_factory_type_scores(sys::state& state);
+
 struct construction_status {
 	float progress = 0.0f; // in range [0,1)
 	bool is_under_construction = false;
@@ -0,0 +1,354 @@
+#include "economy_history.hpp"
+#include "system_state.hpp"
+#include "demographics.hpp"
+#include "economy.hpp"
+#include "nations.hpp"
+#include "serialization.hpp"
+
+#define ZSTD_STATIC_LINKING_ONLY
+#define XXH_NAMESPACE ZSTD_
+#include "zstd.h"
+
+namespace economy_history {
+
+store::store() {
+	tables[uint8_t(series::price)].cadence = 30;
+	tables[uint8_t(series::gdp)].cadence = 30;
+	tables[uint8_t(series::treasury)].cadence = 1;
+	tables[uint8_t(series::population)].cadence = 1;
+	tables[uint8_t(series::trade_volume)].cadence = 7;
+}
+
+uint32_t price_column(sys::state& state, dcon::state_definition_id d, dcon::commodity_id c) {
+	return uint32_t(d.index()) * state.world.commodity_size() + uint32_t(c.index());
+}
+
+static uint32_t group_count(uint32_t columns) {
+	return (columns + columns_per_group - 1) / columns_per_group;
+}
+
+block encode(float const* values, uint32_t columns, uint16_t first_date, uint16_t step) {
+	block result;
+	result.first_date = first_date;
+	result.step = step;
+	result.columns = columns;
+
+	std::vector<uint32_t> words;
+	std::vector<uint8_t> bytes;
+	for(uint32_t g = 0; g < group_count(columns); ++g) {
+		auto first_column = g * columns_per_group;
+		auto last_column = std::min(columns, first_column + columns_per_group);
+		auto count = size_t(last_column - first_column) * block_length;
+
+		words.resize(count);
+		for(uint32_t c = first_column; c < last_column; ++c) {
+			uint32_t previous = 0;
+			for(uint32_t r = 0; r < block_length; ++r) {
+				uint32_t bits = 0;
+				memcpy(&bits, values + size_t(c) * block_length + r, sizeof(uint32_t));
+				words[size_t(c - first_column) * block_length + r] = bits ^ previous;
+				previous = bits;
+			}
+		}
+		// most of the change is in the low bytes, so the high bytes of every word end up in long runs of zeroes
+		bytes.resize(count * sizeof(uint32_t));
+		for(size_t i = 0; i < count; ++i) {
+			for(size_t k = 0; k < sizeof(uint32_t); ++k)
+				bytes[k * count + i] = uint8_t(words[i] >> (8 * k));
+		}
+
+		auto offset = result.data.size();
+		result.group_offsets.push_back(uint32_t(offset));
+		result.data.resize(offset + ZSTD_compressBound(bytes.size()));
+		auto written = ZSTD_compress(result.data.data() + offset, result.data.size() - offset, bytes.data(), bytes.size(), 0);
+		assert(!ZSTD_isError(written));
+		result.data.resize(offset + written);
+	}
+	result.group_offsets.push_back(uint32_t(result.data.size()));
+	result.data.shrink_to_fit();
+	return result;
+}
+
+// unpacks the group of columns g into out, block_length values per column
+static void decode_group(block const& b, uint32_t g, std::vector<float>& out) {
+	auto first_column = g * columns_per_group;
+	auto last_column = std::min(b.columns, first_column + columns_per_group);
+	auto count = size_t(last_column - first_column) * block_length;
+
+	std::vector<uint8_t> bytes(count * sizeof(uint32_t));
+	auto read = ZSTD_decompress(bytes.data(), bytes.size(), b.data.data() + b.group_offsets[g], b.group_offsets[g + 1] - b.group_offsets[g]);
+	if(ZSTD_isError(read) || read != bytes.size()) {
+		out.assign(count, 0.0f);
+		return;
+	}
+
+	out.resize(count);
+	for(size_t c = 0; c < count / block_length; ++c) {
+		uint32_t previous = 0;
+		for(uint32_t r = 0; r < block_length; ++r) {
+			auto i = c * block_length + r;
+			uint32_t word = 0;
+			for(size_t k = 0; k < sizeof(uint32_t); ++k)
+				word |= uint32_t(bytes[k * count + i]) << (8 * k);
+			previous = word ^ previous;
+			memcpy(&out[i], &previous, sizeof(float));
+		}
+	}
+}
+
+void decode(block const& b, std::vector<float>& out) {
+	out.assign(size_t(b.columns) * block_length, 0.0f);
+	std::vector<float> group;
+	for(uint32_t g = 0; g < group_count(b.columns); ++g) {
+		decode_group(b, g, group);
+		std::copy(group.begin(), group.end(), out.begin() + size_t(g) * columns_per_group * block_length);
+	}
+}
+
+// two consecutive blocks of the same resolution become one block at half the resolution, each sample being the mean of two
+static block merge(block const& older, block const& newer) {
+	std::vector<float> a;
+	std::vector<float> b;
+	decode(older, a);
+	decode(newer, b);
+
+	auto columns = std::max(older.columns, newer.columns);
+	std::vector<float> merged(size_t(columns) * block_length, 0.0f);
+	for(uint32_t c = 0; c < columns; ++c) {
+		for(uint32_t r = 0; r < block_length; ++r) {
+			auto& source = r < block_length / 2 ? a : b;
+			auto source_columns = r < block_length / 2 ? older.columns : newer.columns;
+			if(c >= source_columns)
+				continue;
+			auto source_row = (r % (block_length / 2)) * 2;
+			auto base = size_t(c) * block_length + source_row;
+			merged[size_t(c) * block_length + r] = (source[base] + source[base + 1]) * 0.5f;
+		}
+	}
+	return encode(merged.data(), columns, older.first_date, uint16_t(older.step * 2));
+}
+
+void compact(table& t) {
+	// blocks of the same resolution sit next to each other, with coarser ones before finer ones
+	bool merged = true;
+	while(merged) {
+		merged = false;
+		size_t i = 0;
+		while(i < t.sealed.size()) {
+			size_t j = i;
+			while(j < t.sealed.size() && t.sealed[j].step == t.sealed[i].step)
+				++j;
+			if(j - i > blocks_per_level) {
+				t.sealed[i] = merge(t.sealed[i], t.sealed[i + 1]);
+				t.sealed.erase(t.sealed.begin() + i + 1);
+				merged = true;
+				break;
+			}
+			i = j;
+		}
+	}
+}
+
+static uint32_t column_count(sys::state& state, series s) {
+	switch(s) {
+	case series::price:
+		return state.world.state_definition_size() * state.world.commodity_size();
+	case series::gdp:
+	case series::treasury:
+	case series::population:
+		return state.world.nation_size();
+	case series::trade_volume:
+		return state.world.commodity_size();
+	default:
+		return 0;
+	}
+}
+
+template<typename F>
+static void fill_row(sys::state& state, series s, F&& set) {
+	switch(s) {
+	case series::price:
+	{
+		auto commodities = state.world.commodity_size();
+		std::vector<float> totals(size_t(state.world.state_definition_size()) * commodities, 0.0f);
+		std::vector<uint32_t> markets(state.world.state_definition_size(), 0);
+		for(uint32_t m = 0; m < state.world.market_size(); ++m) {
+			dcon::market_id mid{ dcon::market_id::value_base_t(m) };
+			if(!state.world.market_is_valid(mid))
+				continue;
+			auto d = state.world.state_instance_get_definition(state.world.market_get_zone_from_local_market(mid));
+			if(!d)
+				continue;
+			++markets[d.index()];
+			for(uint32_t c = 0; c < commodities; ++c) {
+				dcon::commodity_id cid{ dcon::commodity_id::value_base_t(c) };
+				totals[price_column(state, d, cid)] += state.world.market_get_price(mid, cid);
+			}
+		}
+		for(uint32_t d = 0; d < markets.size(); ++d) {
+			if(markets[d] == 0)
+				continue;
+			for(uint32_t c = 0; c < commodities; ++c)
+				set(d * commodities + c, totals[size_t(d) * commodities + c] / float(markets[d]));
+		}
+		break;
+	}
+	case series::gdp:
+		for(auto n : state.world.in_nation) {
+			if(n.get_owned_province_count() != 0)
+				set(uint32_t(n.id.index()), economy::gdp_adjusted(state, n));
+		}
+		break;
+	case series::treasury:
+		for(auto n : state.world.in_nation) {
+			if(n.get_owned_province_count() != 0)
+				set(uint32_t(n.id.index()), nations::get_treasury(state, n));
+		}
+		break;
+	case series::population:
+		for(auto n : state.world.in_nation) {
+			set(uint32_t(n.id.index()), n.get_demographics(demographics::total));
+		}
+		break;
+	case series::trade_volume:
+		for(uint32_t c = 0; c < state.active_trade_routes.by_commodity.size(); ++c) {
+			dcon::commodity_id cid{ dcon::commodity_id::value_base_t(c) };
+			float total = 0.0f;
+			for(auto route : state.active_trade_routes.by_commodity[c])
+				total += std::abs(state.world.trade_route_get_volume(route, cid));
+			set(c, total);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void append_day(sys::state& state) {
+	auto& s = state.economic_history;
+	std::lock_guard lock{ s.lock };
+
+	for(uint8_t k = 0; k < uint8_t(series::count); ++k) {
+		auto& t = s.tables[k];
+		if(state.current_date.value % t.cadence != 0)
+			continue;
+
+		// the values of the open block are stored column by column, so new columns can simply be added at the end
+		auto columns = std::max(t.columns, column_count(state, series(k)));
+		if(t.open_rows == 0) {
+			t.open_first_date = state.current_date.value;
+			t.open_values.assign(size_t(columns) * block_length, 0.0f);
+		} else if(columns != t.columns) {
+			t.open_values.resize(size_t(columns) * block_length, 0.0f);
+		}
+		t.columns = columns;
+
+		auto row = t.open_rows;
+		fill_row(state, series(k), [&](uint32_t column, float value) {
+			t.open_values[size_t(column) * block_length + row] = value;
+		});
+		++t.open_rows;
+
+		if(t.open_rows == block_length) {
+			t.sealed.push_back(encode(t.open_values.data(), t.columns, t.open_first_date, t.cadence));
+			t.open_rows = 0;
+			compact(t);
+		}
+	}
+}
+
+std::vector<sample> query(sys::state& state, series s, uint32_t column, sys::date from, sys::date to) {
+	auto& st = state.economic_history;
+	std::lock_guard lock{ st.lock };
+
+	std::vector<sample> result;
+	if(uint8_t(s) >= uint8_t(series::count))
+		return result;
+	auto const& t = st.tables[uint8_t(s)];
+
+	auto add = [&](uint32_t date_value, float value) {
+		if(from.value <= date_value && date_value <= to.value) {
+			sample v;
+			v.date.value = uint16_t(date_value);
+			v.value = value;
+			result.push_back(v);
+		}
+	};
+
+	std::vector<float> group;
+	for(auto const& b : t.sealed) {
+		auto last_date = uint32_t(b.first_date) + uint32_t(b.step) * (block_length - 1);
+		if(column >= b.columns || last_date < from.value || b.first_date > to.value)
+			continue;
+		auto g = column / columns_per_group;
+		decode_group(b, g, group);
+		auto base = size_t(column - g * columns_per_group) * block_length;
+		for(uint32_t r = 0; r < block_length; ++r)
+			add(uint32_t(b.first_date) + uint32_t(b.step) * r, group[base + r]);
+	}
+	if(column < t.columns) {
+		for(uint32_t r = 0; r < t.open_rows; ++r)
+			add(uint32_t(t.open_first_date) + uint32_t(t.cadence) * r, t.open_values[size_t(column) * block_length + r]);
+	}
+	return result;
+}
+
+size_t serialize_size(store const& s) {
+	std::lock_guard lock{ s.lock };
+	size_t sz = 0;
+	for(auto const& t : s.tables) {
+		sz += sizeof(t.cadence) + sizeof(t.columns) + sizeof(t.open_first_date) + sizeof(t.open_rows);
+		sz += sys::serialize_size(t.open_values);
+		sz += sizeof(uint32_t);
+		for(auto const& b : t.sealed) {
+			sz += sizeof(b.first_date) + sizeof(b.step) + sizeof(b.columns);
+			sz += sys::serialize_size(b.group_offsets);
+			sz += sys::serialize_size(b.data);
+		}
+	}
+	return sz;
+}
+
+uint8_t* serialize(uint8_t* ptr_in, store const& s) {
+	std::lock_guard lock{ s.lock };
+	for(auto const& t : s.tables) {
+		ptr_in = sys::memcpy_serialize(ptr_in, t.cadence);
+		ptr_in = sys::memcpy_serialize(ptr_in, t.columns);
+		ptr_in = sys::memcpy_serialize(ptr_in, t.open_first_date);
+		ptr_in = sys::memcpy_serialize(ptr_in, t.open_rows);
+		ptr_in = sys::serialize(ptr_in, t.open_values);
+		ptr_in = sys::memcpy_serialize(ptr_in, uint32_t(t.sealed.size()));
+		for(auto const& b : t.sealed) {
+			ptr_in = sys::memcpy_serialize(ptr_in, b.first_date);
+			ptr_in = sys::memcpy_serialize(ptr_in, b.step);
+			ptr_in = sys::memcpy_serialize(ptr_in, b.columns);
+			ptr_in = sys::serialize(ptr_in, b.group_offsets);
+			ptr_in = sys::serialize(ptr_in, b.data);
+		}
+	}
+	return ptr_in;
+}
+
+uint8_t const* deserialize(uint8_t const* ptr_in, store& s) {
+	std::lock_guard lock{ s.lock };
+	for(auto& t : s.tables) {
+		ptr_in = sys::memcpy_deserialize(ptr_in, t.cadence);
+		ptr_in = sys::memcpy_deserialize(ptr_in, t.columns);
+		ptr_in = sys::memcpy_deserialize(ptr_in, t.open_first_date);
+		ptr_in = sys::memcpy_deserialize(ptr_in, t.open_rows);
+		ptr_in = sys::deserialize(ptr_in, t.open_values);
+		uint32_t count = 0;
+		ptr_in = sys::memcpy_deserialize(ptr_in, count);
+		t.sealed.resize(count);
+		for(auto& b : t.sealed) {
+			ptr_in = sys::memcpy_deserialize(ptr_in, b.first_date);
+			ptr_in = sys::memcpy_deserialize(ptr_in, b.step);
+			ptr_in = sys::memcpy_deserialize(ptr_in, b.columns);
+			ptr_in = sys::deserialize(ptr_in, b.group_offsets);
+			ptr_in = sys::deserialize(ptr_in, b.data);
+		}
+	}
+	return ptr_in;
+}
+
+} // namespace economy_history
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stdint.h>
+#include <array>
+#include <mutex>
+#include <vector>
+#include "dcon_generated.hpp"
+#include "date_interface.hpp"
+
+// The long term record of the economy: market prices, national gdp, treasury and population, and the world trade volume of
+// each commodity. Each series is a table with one column per state and commodity, nation, or commodity, sampled at the end
+// of every `cadence` days. Samples go into an open block; once it is full it is compressed column by column (each value is
+// stored as the xor with the previous value of its column, the bytes are regrouped by significance and the result goes
+// through zstd), in groups of columns so that a query only has to unpack the group it reads from.
+//
+// To keep the memory bounded over a long game, when there are more than blocks_per_level blocks of the same resolution the
+// two oldest of them are merged into one block at half the resolution. Recent history stays at full resolution and older
+// history thins out, so the number of blocks only grows with the logarithm of the length of the game.
+
+namespace sys {
+struct state;
+}
+
+namespace economy_history {
+
+enum class series : uint8_t {
+	price,			// column = state_definition * commodity_size + commodity
+	gdp,			// column = nation
+	treasury,		// column = nation
+	population,		// column = nation
+	trade_volume,	// column = commodity
+	count
+};
+
+inline constexpr uint32_t block_length = 32; // samples per column in a block
+inline constexpr uint32_t blocks_per_level = 4;
+inline constexpr uint32_t columns_per_group = 256;
+
+struct block {
+	uint16_t first_date = 0; // the sys::date value of the first sample
+	uint16_t step = 1; // days between two samples
+	uint32_t columns = 0;
+	std::vector<uint32_t> group_offsets; // where each group of columns starts in data, followed by the end of data
+	std::vector<uint8_t> data;
+};
+
+struct table {
+	uint16_t cadence = 1; // days between two samples at full resolution
+	uint32_t columns = 0;
+	uint16_t open_first_date = 0;
+	uint32_t open_rows = 0;
+	std::vector<float> open_values; // block_length values per column
+	std::vector<block> sealed; // oldest first; the resolution never gets coarser towards the present
+};
+
+struct store {
+	std::array<table, size_t(series::count)> tables;
+	mutable std::mutex lock; // samples are appended by the game thread while the ui, the web api and saving may be reading
+
+	store();
+};
+
+struct sample {
+	sys::date date;
+	float value = 0.0f;
+};
+
+// markets are destroyed and their ids reused when states split or merge, so prices are recorded by state definition; a state
+// split between several owners records the mean price of its markets
+uint32_t price_column(sys::state& state, dcon::state_definition_id d, dcon::commodity_id c);
+
+// game thread, at the end of the day
+void append_day(sys::state& state);
+// the samples of one column between two dates (inclusive), oldest first
+std::vector<sample> query(sys::state& state, series s, uint32_t column, sys::date from, sys::date to);
+
+// the block codec and the merging of old blocks, used by append_day (and the tests)
+
+// values holds block_length values for each column
+block encode(float const* values, uint32_t columns, uint16_t first_date, uint16_t step);
+// unpacks a whole block into out, block_length values per column
+void decode(block const& b, std::vector<float>& out);
+// merges the oldest blocks of each resolution until there are at most blocks_per_level of them
+void compact(table& t);
+
+size_t serialize_size(store const& s);
+uint8_t* serialize(uint8_t* ptr_in, store const& s);
+uint8_t const* deserialize(uint8_t const* ptr_in, store& s);
+
+} // namespace economy_history
@@ -0,0 +1,307 @@
+#include "economy_telemetry.hpp"
+#include "system_state.hpp"
+#include "demographics.hpp"
+#include "economy.hpp"
+#include "nations.hpp"
+
+namespace economy_telemetry {
+
+static constexpr native_char const* dump_name = NATIVE("economy_dump.bin");
+static constexpr native_char const* csv_name = NATIVE("economy_dump.csv");
+static constexpr size_t csv_chunk_size = size_t(16) * 1024 * 1024;
+
+template<typename T>
+static void put(std::vector<uint8_t>& out, T value) {
+	auto at = out.size();
+	out.resize(at + sizeof(T));
+	memcpy(out.data() + at, &value, sizeof(T));
+}
+
+static void put_name(std::vector<uint8_t>& out, std::string const& name) {
+	auto length = uint16_t(std::min(name.size(), size_t(UINT16_MAX)));
+	put(out, length);
+	out.insert(out.end(), name.begin(), name.begin() + length);
+}
+
+template<typename T>
+static bool get(uint8_t const*& ptr, uint8_t const* end, T& value) {
+	if(size_t(end - ptr) < sizeof(T))
+		return false;
+	memcpy(&value, ptr, sizeof(T));
+	ptr += sizeof(T);
+	return true;
+}
+
+static bool get_name(uint8_t const*& ptr, uint8_t const* end, std::string& name) {
+	uint16_t length = 0;
+	if(!get(ptr, end, length) || size_t(end - ptr) < length)
+		return false;
+	name.assign(reinterpret_cast<char const*>(ptr), length);
+	ptr += length;
+	return true;
+}
+
+static void run_writer(sink& s, simple_fs::directory dir) {
+	std::vector<uint8_t> batch;
+	while(true) {
+		auto seen = s.wake.load(std::memory_order::acquire);
+		bool finishing = !s.running.load(std::memory_order::acquire);
+
+		// one append for everything that is waiting
+		batch.clear();
+		while(auto day = s.filled.front()) {
+			batch.insert(batch.end(), day->begin(), day->end());
+			std::vector<uint8_t> emptied = std::move(*day);
+			s.filled.pop();
+			emptied.clear();
+			s.spare.try_push(std::move(emptied));
+		}
+		if(!batch.empty())
+			simple_fs::append_file(dir, dump_name, reinterpret_cast<char const*>(batch.data()), uint32_t(batch.size()));
+
+		if(finishing)
+			break;
+		s.wake.wait(seen, std::memory_order::acquire);
+	}
+
+	if(s.write_csv)
+		convert_to_csv(dir, dump_name, csv_name);
+	s.finished.store(true, std::memory_order::release);
+}
+
+sink::~sink() {
+	running.store(false, std::memory_order::release);
+	wake.fetch_add(1, std::memory_order::acq_rel);
+	wake.notify_one();
+	if(writer.joinable())
+		writer.join();
+}
+
+bool start(sys::state& state) {
+	auto& s = state.cheat_data.ecodump_sink;
+	if(s.writer.joinable()) {
+		// the previous writer was already told to stop, but it may still be busy with a long csv
+		if(!s.finished.load(std::memory_order::acquire))
+			return false;
+		s.writer.join();
+	}
+	while(s.filled.front())
+		s.filled.pop();
+	s.dropped_days.store(0, std::memory_order::release);
+
+	std::vector<uint8_t> header;
+	put(header, file_magic);
+	put(header, format_version);
+	put(header, uint32_t(state.world.commodity_size()));
+	state.world.for_each_commodity([&](dcon::commodity_id c) {
+		put_name(header, text::produce_simple_string(state, state.world.commodity_get_name(c)));
+	});
+	put(header, uint32_t(state.world.pop_type_size()));
+	state.world.for_each_pop_type([&](dcon::pop_type_id pt) {
+		put_name(header, text::produce_simple_string(state, state.world.pop_type_get_name(pt)));
+	});
+
+	auto dir = simple_fs::get_or_create_data_dumps_directory();
+	simple_fs::write_file(dir, dump_name, reinterpret_cast<char const*>(header.data()), uint32_t(header.size()));
+
+	s.write_csv = false;
+	s.finished.store(false, std::memory_order::release);
+	s.running.store(true, std::memory_order::release);
+	s.writer = std::thread([&s, dir]() { run_writer(s, dir); });
+	return true;
+}
+
+uint32_t stop(sys::state& state, bool write_csv) {
+	auto& s = state.cheat_data.ecodump_sink;
+	if(!s.running.load(std::memory_order::acquire))
+		return 0;
+	s.write_csv = write_csv;
+	s.running.store(false, std::memory_order::release);
+	s.wake.fetch_add(1, std::memory_order::acq_rel);
+	s.wake.notify_one();
+	// not joined here: the writer may still have a queue to finish and a csv to write; the next start joins it once it
+	// is finished, and the destructor waits for it
+	return s.dropped_days.load(std::memory_order::acquire);
+}
+
+void record_day(sys::state& state) {
+	auto& s = state.cheat_data.ecodump_sink;
+	if(!s.running.load(std::memory_order::acquire))
+		return;
+
+	std::vector<uint8_t> out;
+	if(auto spare = s.spare.front()) {
+		out = std::move(*spare);
+		s.spare.pop();
+	}
+	out.clear();
+
+	auto const markets = state.world.market_size();
+	auto const nations = state.world.nation_size();
+	auto const commodities = state.world.commodity_size();
+	auto const pop_types = state.world.pop_type_size();
+	auto const workers = state.culture_definitions.primary_factory_worker;
+
+	put(out, uint32_t(0)); // size, filled in below
+	put(out, uint32_t(state.current_date.value));
+	put(out, uint32_t(markets));
+	put(out, uint32_t(nations));
+
+	for(uint32_t i = 0; i < markets; i++) {
+		dcon::market_id m{ dcon::market_id::value_base_t(i) };
+		auto n = state.world.state_instance_get_nation_from_state_ownership(state.world.market_get_zone_from_local_market(m));
+		put(out, int32_t(n ? n.index() : -1));
+	}
+	for(uint32_t i = 0; i < markets; i++)
+		put(out, state.world.market_get_gdp(dcon::market_id{ dcon::market_id::value_base_t(i) }));
+	for(uint32_t i = 0; i < markets; i++) {
+		dcon::market_id m{ dcon::market_id::value_base_t(i) };
+		put(out, state.world.state_instance_get_demographics(state.world.market_get_zone_from_local_market(m), demographics::total));
+	}
+	for(uint32_t i = 0; i < markets; i++) {
+		dcon::market_id m{ dcon::market_id::value_base_t(i) };
+		put(out, state.world.market_get_life_needs_costs(m, workers)
+			+ state.world.market_get_everyday_needs_costs(m, workers)
+			+ state.world.market_get_luxury_needs_costs(m, workers));
+	}
+	for(uint32_t i = 0; i < markets; i++)
+		put(out, state.world.market_get_stockpile(dcon::market_id{ dcon::market_id::value_base_t(i) }, economy::money));
+
+	for(uint32_t k = 0; k < commodities; k++) {
+		dcon::commodity_id c{ dcon::commodity_id::value_base_t(k) };
+		for(uint32_t i = 0; i < markets; i++)
+			put(out, state.world.market_get_price(dcon::market_id{ dcon::market_id::value_base_t(i) }, c));
+		for(uint32_t i = 0; i < markets; i++)
+			put(out, state.world.market_get_supply(dcon::market_id{ dcon::market_id::value_base_t(i) }, c));
+		for(uint32_t i = 0; i < markets; i++)
+			put(out, state.world.market_get_demand(dcon::market_id{ dcon::market_id::value_base_t(i) }, c));
+	}
+
+	for(uint32_t i = 0; i < nations; i++) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
+		put(out, uint32_t(state.world.national_identity_get_identifying_int(state.world.nation_get_identity_from_identity_holder(n))));
+	}
+	for(uint32_t i = 0; i < nations; i++)
+		put(out, state.world.nation_get_stockpiles(dcon::nation_id{ dcon::nation_id::value_base_t(i) }, economy::money));
+	for(uint32_t i = 0; i < nations; i++)
+		put(out, state.world.nation_get_private_investment(dcon::nation_id{ dcon::nation_id::value_base_t(i) }));
+
+	std::vector<float> savings(pop_types, 0.0f);
+	state.world.for_each_pop([&](dcon::pop_id p) {
+		auto pt = state.world.pop_get_poptype(p);
+		if(pt)
+			savings[pt.index()] += state.world.pop_get_savings(p);
+	});
+	for(auto v : savings)
+		put(out, v);
+
+	auto size = uint32_t(out.size() - sizeof(uint32_t));
+	memcpy(out.data(), &size, sizeof(uint32_t));
+
+	if(s.filled.try_push(std::move(out))) {
+		s.wake.fetch_add(1, std::memory_order::acq_rel);
+		s.wake.notify_one();
+	} else {
+		s.dropped_days.fetch_add(1, std::memory_order::acq_rel);
+	}
+}
+
+bool convert_to_csv(simple_fs::directory const& dir, native_string_view binary_name, native_string_view csv_name) {
+	auto file = simple_fs::open_file(dir, binary_name);
+	if(!file)
+		return false;
+	auto contents = simple_fs::view_contents(*file);
+	auto ptr = reinterpret_cast<uint8_t const*>(contents.data);
+	auto end = ptr + contents.file_size;
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t commodities = 0;
+	uint32_t pop_types = 0;
+	if(!get(ptr, end, magic) || magic != file_magic || !get(ptr, end, version) || version != format_version)
+		return false;
+	if(!get(ptr, end, commodities))
+		return false;
+	std::vector<std::string> commodity_names(commodities);
+	for(auto& name : commodity_names) {
+		if(!get_name(ptr, end, name))
+			return false;
+	}
+	if(!get(ptr, end, pop_types))
+		return false;
+	std::vector<std::string> pop_type_names(pop_types);
+	for(auto& name : pop_type_names) {
+		if(!get_name(ptr, end, name))
+			return false;
+	}
+
+	std::string out = "date,series,commodity,id,value\n";
+	simple_fs::write_file(dir, csv_name, out.c_str(), uint32_t(out.size()));
+	out.clear();
+
+	auto flush = [&](bool always) {
+		if(!out.empty() && (always || out.size() >= csv_chunk_size)) {
+			simple_fs::append_file(dir, csv_name, out.c_str(), uint32_t(out.size()));
+			out.clear();
+		}
+	};
+
+	while(ptr < end) {
+		uint32_t size = 0;
+		if(!get(ptr, end, size) || size_t(end - ptr) < size)
+			break; // a day that was cut off
+		auto day_end = ptr + size;
+		uint32_t date = 0;
+		uint32_t markets = 0;
+		uint32_t nations = 0;
+		if(!get(ptr, day_end, date) || !get(ptr, day_end, markets) || !get(ptr, day_end, nations))
+			break;
+		auto date_str = std::to_string(date);
+
+		auto float_column = [&](char const* series, std::string const& commodity, uint32_t count) {
+			for(uint32_t i = 0; i < count; i++) {
+				float v = 0.0f;
+				if(!get(ptr, day_end, v))
+					return;
+				out += date_str + "," + series + "," + commodity + "," + std::to_string(i) + "," + std::to_string(v) + "\n";
+			}
+		};
+
+		for(uint32_t i = 0; i < markets; i++) {
+			int32_t owner = 0;
+			if(!get(ptr, day_end, owner))
+				break;
+			out += date_str + ",owner,," + std::to_string(i) + "," + std::to_string(owner) + "\n";
+		}
+		float_column("gdp", "", markets);
+		float_column("population", "", markets);
+		float_column("life_costs", "", markets);
+		float_column("money", "", markets);
+		for(uint32_t k = 0; k < commodities; k++) {
+			float_column("price", commodity_names[k], markets);
+			float_column("supply", commodity_names[k], markets);
+			float_column("demand", commodity_names[k], markets);
+		}
+		for(uint32_t i = 0; i < nations; i++) {
+			uint32_t tag = 0;
+			if(!get(ptr, day_end, tag))
+				break;
+			out += date_str + ",tag,," + std::to_string(i) + "," + nations::int_to_tag(tag) + "\n";
+		}
+		float_column("treasury", "", nations);
+		float_column("private_investment", "", nations);
+		for(uint32_t i = 0; i < pop_types; i++) {
+			float v = 0.0f;
+			if(!get(ptr, day_end, v))
+				break;
+			out += date_str + ",savings,," + pop_type_names[i] + "," + std::to_string(v) + "\n";
+		}
+
+		ptr = day_end;
+		flush(false);
+	}
+	flush(true);
+	return true;
+}
+
+} // namespace economy_telemetry
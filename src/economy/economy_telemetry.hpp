@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "SPSCQueue.h"
+#include "simple_fs.hpp"
+
+// The economy dump of the ecodump cheat. The dump-econ console command (on the ui thread) starts and stops it. While it is
+// on, the game thread packs a record of every day (markets, nations and pop savings) into a buffer at the end of the
+// economy update and hands it to a writer thread through a lock free queue; the writer appends the records to
+// economy_dump.bin in the data dumps directory. Neither the tick nor the console ever waits for the disk: when the writer
+// falls too far behind, days are dropped and counted instead, and a new dump can't start until the writer of the last one
+// has finished its queue and its csv.
+//
+// The file starts with a header (magic, format version, then the commodity and pop type names, each as a uint16 length
+// followed by utf8), followed by one block per day. A block is a uint32 size of the rest of the block, then the date, the
+// number of markets and the number of nations as uint32, then whole columns one after the other:
+//	per market: owner nation index (int32, -1 if none), gdp, population, life + everyday + luxury costs of primary factory
+//	workers, money stockpile
+//	per commodity and market: price, then supply, then demand
+//	per nation: identifying tag (uint32), treasury, private investment
+//	per pop type: total savings
+// Everything that is not marked otherwise is a float, and all values are in native byte order.
+
+namespace sys {
+struct state;
+}
+
+namespace economy_telemetry {
+
+inline constexpr uint32_t file_magic = 0x4f434541; // "AECO"
+inline constexpr uint32_t format_version = 1;
+inline constexpr uint32_t queue_capacity = 64; // days that may be waiting for the writer
+
+struct sink {
+	rigtorp::SPSCQueue<std::vector<uint8_t>> filled{ queue_capacity };	// game thread (record_day) -> writer
+	rigtorp::SPSCQueue<std::vector<uint8_t>> spare{ queue_capacity };	// writer -> game thread, so that buffers are reused
+	std::atomic<uint32_t> wake = 0;
+	std::atomic<bool> running = false;
+	std::atomic<bool> finished = true; // set by the writer once it has written everything, including the csv
+	std::atomic<uint32_t> dropped_days = 0;
+	bool write_csv = false;
+	std::thread writer;
+
+	~sink();
+};
+
+// ui thread (the dump-econ console command): starting writes the header and launches the writer, and fails without
+// waiting if the writer of the previous dump is still busy; stopping lets the writer finish the queue, and then convert
+// the file to csv if asked to. Stopping returns the number of days that were dropped, since those are missing from the
+// file
+bool start(sys::state& state);
+uint32_t stop(sys::state& state, bool write_csv);
+// game thread, at the end of the economy update; does nothing unless the dump is running
+void record_day(sys::state& state);
+
+// reads a dump and writes it out as date,series,commodity,id,value lines
+bool convert_to_csv(simple_fs::directory const& dir, native_string_view binary_name, native_string_view csv_name);
+
+} // namespace economy_telemetry
@@ -342,6 +342,7 @@ int main (int argc, char *argv[]) {
 
 	network::init(game_state);
 	game_state.load_user_settings();
+	game_state.adaptive_monthly_schedule = true; // only takes effect in single player
 	ui::populate_definitions_map(game_state);
 	std::thread update_thread([&]() { game_state.game_loop(); });
 	window::emit_error_message("Starting the game.\n", false);
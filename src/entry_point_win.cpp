@@ -286,6 +286,7 @@ int WINAPI wWinMain(HINSTANCE /*hInstance*/, HINSTANCE /*hPrevInstance*/, LPWSTR
 
 		// scenario loading functions (would have to run these even when scenario is pre-built)
 		game_state.load_user_settings();
+		game_state.adaptive_monthly_schedule = true; // only takes effect in single player
 		ui::populate_definitions_map(game_state);
 
 		if(game_state.network_mode == sys::network_mode_type::host) {
@@ -6407,6 +6407,10 @@ void execute_command(sys::state& state, payload& c) {
 void execute_pending_commands(sys::state& state) {
 	auto* c = state.incoming_commands.front();
 	bool command_executed = false;
+	// nearly any command can change what the budget estimates depend on, for the nation sending it and for others
+	// (subsidies, reparations, subjects), so none of the copies are read until the batch is done
+	if(c)
+		economy::invalidate_budget_projections(state);
 	while(c) {
 		command_executed = true;
 		execute_command(state, *c);
@@ -6418,6 +6422,9 @@ void execute_pending_commands(sys::state& state) {
 		province::update_connected_regions(state);
 		province::update_cached_values(state);
 		nations::update_cached_values(state);
+		if(!state.defer_ui_update)
+			economy::update_budget_projections(state);
+		ui_snapshot::take(state);
 		state.game_state_updated.store(true, std::memory_order::release);
 	}
 }
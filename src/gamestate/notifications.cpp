@@ -3,6 +3,8 @@
 
 namespace notification {
 
+static std::mutex post_lock;
+
 void post(sys::state& state, message&& m) {
 	//
 	// TODO: pre filter out any messages that the player is not interested in at all according to their message settings.
@@ -10,6 +12,8 @@ void post(sys::state& state, message&& m) {
 	// as that will probably be a more computationally expensive check
 	//
 
+	// new_messages is a single producer queue, but independent updates in the daily tick graph may post at the same time
+	std::lock_guard l{ post_lock };
 	bool v = state.new_messages.try_emplace(std::move(m));
 	assert(v);
 }
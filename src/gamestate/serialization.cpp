@@ -709,6 +709,8 @@ uint8_t const* read_save_section(uint8_t const* ptr_in, uint8_t const* section_e
 		ptr_in = memcpy_deserialize(ptr_in, state.military_definitions.world_wars_enabled);
 	}
 
+	ptr_in = economy_history::deserialize(ptr_in, state.economic_history);
+
 	// data container contribution
 
 	dcon::load_record loaded;
@@ -760,6 +762,7 @@ uint8_t* write_save_section(uint8_t* ptr_in, sys::state& state) {
 		ptr_in = memcpy_serialize(ptr_in, state.military_definitions.great_wars_enabled);
 		ptr_in = memcpy_serialize(ptr_in, state.military_definitions.world_wars_enabled);
 	}
+	ptr_in = economy_history::serialize(ptr_in, state.economic_history);
 
 	// data container contribution
 	dcon::load_record loaded = state.world.make_serialize_record_store_full_save();
@@ -807,6 +810,7 @@ size_t sizeof_save_section(sys::state& state) {
 		sz += sizeof(state.military_definitions.great_wars_enabled);
 		sz += sizeof(state.military_definitions.world_wars_enabled);
 	}
+	sz += economy_history::serialize_size(state.economic_history);
 
 	// data container contribution
 	dcon::load_record loaded = state.world.make_serialize_record_store_full_save();
@@ -1046,36 +1050,6 @@ void write_save_file(sys::state& state, save_type type, std::string const& name)
 	delete[] temp_buffer;
 
 	state.save_list_updated.store(true, std::memory_order::release); // update for ui
-
-
-	if(state.cheat_data.ecodump) {
-		auto data_dumps_directory = simple_fs::get_or_create_data_dumps_directory();
-
-		simple_fs::write_file(
-			data_dumps_directory,
-			NATIVE("economy_dump.txt"),
-			state.cheat_data.national_economy_dump_buffer.c_str(),
-			uint32_t(state.cheat_data.national_economy_dump_buffer.size())
-		);
-		simple_fs::write_file(
-			data_dumps_directory,
-			NATIVE("savings_dump.txt"),
-			state.cheat_data.savings_buffer.c_str(),
-			uint32_t(state.cheat_data.savings_buffer.size())
-		);
-		simple_fs::write_file(
-			data_dumps_directory,
-			NATIVE("prices_dump.txt"),
-			state.cheat_data.prices_dump_buffer.c_str(),
-			uint32_t(state.cheat_data.prices_dump_buffer.size())
-		);
-		simple_fs::write_file(
-			data_dumps_directory,
-			NATIVE("demand_dump.txt"),
-			state.cheat_data.demand_dump_buffer.c_str(),
-			uint32_t(state.cheat_data.demand_dump_buffer.size())
-		);
-	}
 }
 bool try_read_save_file(sys::state& state, native_string_view name) {
 	auto dir = simple_fs::get_or_create_save_game_directory();
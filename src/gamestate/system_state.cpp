@@ -39,6 +39,7 @@
 #include "blake2.h"
 #include "fif_common.hpp"
 #include "gui_deserialize.hpp"
+#include "tick_profiler.hpp"
 
 namespace ui {
 
@@ -3667,6 +3668,10 @@ void state::on_scenario_load() {
 void state::fill_unsaved_data() { // reconstructs derived values that are not directly saved after a save has been loaded
 	great_nations.reserve(int32_t(defines.great_nations_count));
 
+	// nothing cached from before the load may be read
+	economy::invalidate_budget_projections(*this);
+	economy::invalidate_factory_type_scores(*this);
+
 	world.nation_resize_modifier_values(sys::national_mod_offsets::count);
 	world.nation_resize_rgo_goods_output(world.commodity_size());
 	world.nation_resize_factory_goods_output(world.commodity_size());
@@ -3902,6 +3907,247 @@ void state::fill_unsaved_data() { // reconstructs derived values that are not di
 	game_state_updated.store(true, std::memory_order::release);
 }
 
+// The once a month updates, in the order they run over the month. The estimated costs are only rough guesses of how
+// long each job takes on a late game save; they decide which day each job runs on in multiplayer (see monthly_schedule).
+void add_monthly_jobs(monthly_schedule& s) {
+	s.add("nations::update_monthly_points", [](sys::state& st, uint32_t, uint32_t) { nations::update_monthly_points(st); }, 1.0f);
+	s.add("economy::prune_factories", [](sys::state& st, uint32_t, uint32_t) { economy::prune_factories(st); }, 1.0f);
+	s.add("province::update_blockaded_cache", [](sys::state& st, uint32_t, uint32_t) { province::update_blockaded_cache(st); }, 0.5f);
+	s.add("sys::update_modifier_effects", [](sys::state& st, uint32_t, uint32_t) { sys::update_modifier_effects(st); }, 4.0f);
+	s.add("military::monthly_leaders_update", [](sys::state& st, uint32_t, uint32_t) { military::monthly_leaders_update(st); }, 0.5f);
+	s.add("ai::add_gw_goals", [](sys::state& st, uint32_t, uint32_t) { ai::add_gw_goals(st); }, 1.0f);
+	s.add("military::reinforce_regiments", [](sys::state& st, uint32_t, uint32_t) { military::reinforce_regiments(st); }, 1.0f);
+	s.add("ai::make_defense", [](sys::state& st, uint32_t, uint32_t) {
+		if(!bool(st.defines.alice_eval_ai_mil_everyday))
+			ai::make_defense(st);
+	}, 3.0f);
+	s.add("rebel::update_movements", [](sys::state& st, uint32_t, uint32_t) { rebel::update_movements(st); }, 1.5f);
+	s.add("rebel::update_factions", [](sys::state& st, uint32_t, uint32_t) { rebel::update_factions(st); }, 1.5f);
+	s.add("ai::form_alliances", [](sys::state& st, uint32_t, uint32_t) { ai::form_alliances(st); }, 1.0f);
+	s.add("ai::make_attacks", [](sys::state& st, uint32_t, uint32_t) {
+		if(!bool(st.defines.alice_eval_ai_mil_everyday))
+			ai::make_attacks(st);
+	}, 3.0f);
+	s.add("ai::update_ai_general_status", [](sys::state& st, uint32_t, uint32_t) { ai::update_ai_general_status(st); }, 1.0f);
+	s.add("military::apply_attrition", [](sys::state& st, uint32_t, uint32_t) { military::apply_attrition(st); }, 1.0f);
+	s.add("military::repair_ships", [](sys::state& st, uint32_t, uint32_t) { military::repair_ships(st); }, 0.5f);
+	s.add("province::update_crimes", [](sys::state& st, uint32_t, uint32_t) { province::update_crimes(st); }, 1.0f);
+	s.add("province::update_nationalism", [](sys::state& st, uint32_t, uint32_t) { province::update_nationalism(st); }, 1.0f);
+	s.add("ai::update_ai_research", [](sys::state& st, uint32_t, uint32_t) { ai::update_ai_research(st); }, 2.0f);
+	s.add("rebel::update_armies", [](sys::state& st, uint32_t, uint32_t) {
+		rebel::update_armies(st);
+		rebel::rebel_hunting_check(st);
+	}, 2.0f);
+	s.add("ai::perform_influence_actions", [](sys::state& st, uint32_t, uint32_t) { ai::perform_influence_actions(st); }, 1.0f);
+	s.add("ai::update_focuses", [](sys::state& st, uint32_t, uint32_t) { ai::update_focuses(st); }, 1.0f);
+	s.add("culture::discover_inventions", [](sys::state& st, uint32_t, uint32_t) { culture::discover_inventions(st); }, 2.0f);
+	s.add("ai::build_ships", [](sys::state& st, uint32_t first, uint32_t last) { ai::build_ships(st, first, last); }, 2.0f, 2);
+	s.add("ai::update_land_constructions", [](sys::state& st, uint32_t first, uint32_t last) { ai::update_land_constructions(st, first, last); }, 4.0f, 2);
+	s.add("ai::update_ai_econ_construction", [](sys::state& st, uint32_t first, uint32_t last) { ai::update_ai_econ_construction(st, first, last); }, 12.0f, 4);
+	s.add("ai::update_budget", [](sys::state& st, uint32_t, uint32_t) { ai::update_budget(st); }, 1.0f);
+	s.add("nations::monthly_flashpoint_update", [](sys::state& st, uint32_t, uint32_t) { nations::monthly_flashpoint_update(st); }, 1.0f);
+	s.add("ai::make_defense", [](sys::state& st, uint32_t, uint32_t) {
+		if(!bool(st.defines.alice_eval_ai_mil_everyday))
+			ai::make_defense(st);
+	}, 3.0f);
+	s.add("ai::update_ai_colony_starting", [](sys::state& st, uint32_t, uint32_t) { ai::update_ai_colony_starting(st); }, 0.5f);
+	s.add("ai::take_reforms", [](sys::state& st, uint32_t, uint32_t) { ai::take_reforms(st); }, 1.0f);
+	s.add("ai::civilize", [](sys::state& st, uint32_t, uint32_t) { ai::civilize(st); }, 0.5f);
+	s.add("ai::make_war_decs", [](sys::state& st, uint32_t, uint32_t) { ai::make_war_decs(st); }, 6.0f);
+	s.add("rebel::execute_rebel_victories", [](sys::state& st, uint32_t, uint32_t) { rebel::execute_rebel_victories(st); }, 0.5f);
+	s.add("ai::make_attacks", [](sys::state& st, uint32_t, uint32_t) {
+		if(!bool(st.defines.alice_eval_ai_mil_everyday))
+			ai::make_attacks(st);
+	}, 3.0f);
+	s.add("rebel::update_armies", [](sys::state& st, uint32_t, uint32_t) {
+		rebel::update_armies(st);
+		rebel::rebel_hunting_check(st);
+	}, 2.0f);
+	s.add("rebel::execute_province_defections", [](sys::state& st, uint32_t, uint32_t) { rebel::execute_province_defections(st); }, 0.5f);
+	s.add("ai::make_peace_offers", [](sys::state& st, uint32_t, uint32_t) { ai::make_peace_offers(st); }, 1.0f);
+	s.add("ai::update_crisis_leaders", [](sys::state& st, uint32_t, uint32_t) { ai::update_crisis_leaders(st); }, 0.5f);
+	s.add("rebel::rebel_risings_check", [](sys::state& st, uint32_t, uint32_t) { rebel::rebel_risings_check(st); }, 1.0f);
+	s.add("ai::update_war_intervention", [](sys::state& st, uint32_t, uint32_t) { ai::update_war_intervention(st); }, 1.0f);
+	s.add("ai::update_ships", [](sys::state& st, uint32_t, uint32_t) {
+		if(!bool(st.defines.alice_eval_ai_mil_everyday))
+			ai::update_ships(st);
+	}, 1.0f);
+	s.add("rebel::update_armies", [](sys::state& st, uint32_t, uint32_t) {
+		rebel::update_armies(st);
+		rebel::rebel_hunting_check(st);
+	}, 2.0f);
+	s.add("ai::update_cb_fabrication", [](sys::state& st, uint32_t, uint32_t) { ai::update_cb_fabrication(st); }, 1.0f);
+	s.add("ai::update_ai_ruling_party", [](sys::state& st, uint32_t, uint32_t) { ai::update_ai_ruling_party(st); }, 0.5f);
+}
+
+// The daily updates that run before the monthly schedule. Each node declares what it reads and writes, and the graph
+// runs whatever doesn't conflict concurrently. Anything that can fire an event, execute an effect, evaluate a scripted
+// trigger or change a province owner must be declared as reading and writing everything, and so acts as a barrier.
+// When adding a node, put it where it would run serially.
+tick_graph& daily_tick_graph() {
+	static tick_graph g = []() {
+		tick_graph r;
+
+		// values updates pass 1 (mostly trivial things)
+		r.add("ai::refresh_home_ports", [](sys::state& s) { ai::refresh_home_ports(s); },
+			tick_data::navies | tick_data::provinces,
+			tick_data::ai);
+		r.add("nations::update_research_points", [](sys::state& s) {
+			// Instant research cheat
+			for(auto n : s.cheat_data.instant_research_nations) {
+				auto tech = s.world.nation_get_current_research(n);
+				if(tech.is_valid()) {
+					float points = culture::effective_technology_rp_cost(s, s.current_date.to_ymd(s.start_date).year, n, tech);
+					s.world.nation_set_research_points(n, points);
+				}
+			}
+			nations::update_research_points(s);
+		},
+			tick_data::demographics | tick_data::national_modifiers | tick_data::research,
+			tick_data::research_points);
+		r.add("military::regenerate_land_unit_average", [](sys::state& s) { military::regenerate_land_unit_average(s); },
+			tick_data::national_modifiers | tick_data::research,
+			tick_data::land_unit_scores);
+		r.add("military::regenerate_ship_scores", [](sys::state& s) { military::regenerate_ship_scores(s); },
+			tick_data::national_modifiers | tick_data::navies,
+			tick_data::ship_scores);
+		r.add("military::update_naval_supply_points", [](sys::state& s) { military::update_naval_supply_points(s); },
+			tick_data::provinces | tick_data::national_modifiers | tick_data::navies,
+			tick_data::naval_supply);
+		r.add("military::update_all_recruitable_regiments", [](sys::state& s) { military::update_all_recruitable_regiments(s); },
+			tick_data::pops | tick_data::national_modifiers,
+			tick_data::recruitable_regiments);
+		r.add("military::regenerate_total_regiment_counts", [](sys::state& s) { military::regenerate_total_regiment_counts(s); },
+			tick_data::armies,
+			tick_data::regiment_counts);
+		r.add("economy::update_factory_employment", [](sys::state& s) { economy::update_factory_employment(s); },
+			tick_data::markets,
+			tick_data::factories);
+		r.add("nations::update_administrative_efficiency", [](sys::state& s) {
+			nations::update_administrative_efficiency(s);
+			rebel::daily_update_rebel_organization(s);
+		},
+			tick_data::pops | tick_data::demographics | tick_data::national_modifiers | tick_data::provinces,
+			tick_data::administration | tick_data::rebels);
+		r.add("military::daily_leaders_update", [](sys::state& s) { military::daily_leaders_update(s); },
+			tick_data::national_modifiers,
+			tick_data::leaders);
+		r.add("politics::daily_party_loyalty_update", [](sys::state& s) { politics::daily_party_loyalty_update(s); },
+			tick_data::national_modifiers | tick_data::politics,
+			tick_data::party_loyalty);
+		r.add("nations::daily_update_flashpoint_tension", [](sys::state& s) { nations::daily_update_flashpoint_tension(s); },
+			tick_data::diplomacy | tick_data::demographics | tick_data::national_modifiers,
+			tick_data::flashpoints);
+		r.add("military::update_ticking_war_score", [](sys::state& s) { military::update_ticking_war_score(s); },
+			tick_data::wars | tick_data::province_control,
+			tick_data::war_score);
+		r.add("military::increase_dig_in", [](sys::state& s) { military::increase_dig_in(s); },
+			tick_data::armies | tick_data::national_modifiers,
+			tick_data::dig_in);
+		r.add("military::update_blockade_status", [](sys::state& s) { military::update_blockade_status(s); },
+			tick_data::navies | tick_data::wars | tick_data::province_control,
+			tick_data::blockades);
+
+		// the economy reads nearly everything, so it still waits for most of the above; finished unit constructions
+		// create armies and navies, which may join or start battles where they appear
+		r.add("economy::daily_update", [](sys::state& s) { economy::daily_update(s, false, 1.f); },
+			tick_data_set::everything().without(tick_data::research_points | tick_data::land_unit_scores | tick_data::ship_scores
+				| tick_data::naval_supply | tick_data::recruitable_regiments | tick_data::regiment_counts | tick_data::party_loyalty
+				| tick_data::flashpoints | tick_data::war_score | tick_data::crisis | tick_data::events),
+			tick_data::markets | tick_data::factories | tick_data::pops | tick_data::nations | tick_data::provinces
+				| tick_data::armies | tick_data::navies);
+
+		r.add("military::recover_org", [](sys::state& s) { military::recover_org(s); },
+			tick_data::national_modifiers | tick_data::provinces | tick_data::leaders | tick_data::markets,
+			tick_data::armies | tick_data::navies);
+		// rebels that take a province run the siege_won trigger and effect of their type
+		r.add("military::update_siege_progress", [](sys::state& s) { military::update_siege_progress(s); },
+			tick_data_set::everything(),
+			tick_data_set::everything());
+		r.add("military::update_movement", [](sys::state& s) { military::update_movement(s); },
+			tick_data::provinces | tick_data::province_control | tick_data::diplomacy | tick_data::wars | tick_data::national_modifiers,
+			tick_data::armies | tick_data::navies);
+		r.add("military::update_naval_battles", [](sys::state& s) { military::update_naval_battles(s); },
+			tick_data::national_modifiers | tick_data::provinces | tick_data::wars,
+			tick_data::navies | tick_data::armies | tick_data::leaders | tick_data::war_score | tick_data::nations);
+		r.add("military::update_land_battles", [](sys::state& s) { military::update_land_battles(s); },
+			tick_data::national_modifiers | tick_data::provinces | tick_data::wars,
+			tick_data::armies | tick_data::leaders | tick_data::war_score | tick_data::nations | tick_data::pops);
+		r.add("military::advance_mobilizations", [](sys::state& s) { military::advance_mobilizations(s); },
+			tick_data::national_modifiers | tick_data::provinces,
+			tick_data::armies | tick_data::pops);
+
+		// the ai finishes its colonies here, which changes province owners
+		r.add("province::update_colonization", [](sys::state& s) { province::update_colonization(s); },
+			tick_data_set::everything(),
+			tick_data_set::everything());
+		r.add("military::update_cbs", [](sys::state& s) { military::update_cbs(s); }, // may add/remove cbs to a nation
+			tick_data::diplomacy | tick_data::national_modifiers | tick_data::ai,
+			tick_data::wars | tick_data::nations);
+
+		// fires events and executes the options the ai picks for them
+		r.add("event::update_events", [](sys::state& s) { event::update_events(s); },
+			tick_data_set::everything(),
+			tick_data_set::everything());
+
+		r.add("culture::update_research", [](sys::state& s) { culture::update_research(s, uint32_t(s.current_date.to_ymd(s.start_date).year)); },
+			tick_data::demographics,
+			tick_data::research | tick_data::research_points | tick_data::national_modifiers | tick_data::nations);
+
+		r.add("nations::update_industrial_scores", [](sys::state& s) { nations::update_industrial_scores(s); },
+			tick_data::factories | tick_data::provinces | tick_data::diplomacy,
+			tick_data::national_scores);
+		r.add("nations::update_military_scores", [](sys::state& s) { nations::update_military_scores(s); },
+			tick_data::land_unit_scores | tick_data::ship_scores | tick_data::recruitable_regiments | tick_data::regiment_counts | tick_data::national_modifiers,
+			tick_data::national_scores);
+		r.add("nations::update_rankings", [](sys::state& s) { nations::update_rankings(s); },
+			tick_data::nations | tick_data::national_modifiers | tick_data::diplomacy | tick_data::provinces,
+			tick_data::national_scores);
+		// fires on_new_great_nation / on_lost_great_nation
+		r.add("nations::update_great_powers", [](sys::state& s) { nations::update_great_powers(s); },
+			tick_data_set::everything(),
+			tick_data_set::everything());
+		r.add("nations::update_influence", [](sys::state& s) { nations::update_influence(s); },
+			tick_data::national_scores | tick_data::national_modifiers | tick_data::nations,
+			tick_data::diplomacy | tick_data::nations);
+
+		// fires on_crisis_declare_interest and runs the on_add effects of the war goals of a crisis war
+		r.add("nations::update_crisis", [](sys::state& s) { nations::update_crisis(s); },
+			tick_data_set::everything(),
+			tick_data_set::everything());
+		// fires the election events; a new ruling party also re-evaluates the triggered modifiers of the nation
+		r.add("politics::update_elections", [](sys::state& s) { politics::update_elections(s); },
+			tick_data_set::everything(),
+			tick_data_set::everything());
+
+		r.add("ai::update_ai_colonial_investment", [](sys::state& s) {
+			if(s.current_date.value % 4 == 0) {
+				ai::update_ai_colonial_investment(s);
+			}
+		},
+			tick_data::provinces | tick_data::province_ownership | tick_data::national_scores | tick_data::diplomacy | tick_data::nations,
+			tick_data::province_ownership | tick_data::nations | tick_data::ai);
+		r.add("ai::daily_military", [](sys::state& s) {
+			if(s.defines.alice_eval_ai_mil_everyday != 0.0f) {
+				ai::make_defense(s);
+				ai::make_attacks(s);
+				ai::update_ships(s);
+			}
+		},
+			tick_data_set::everything().without(tick_data::research_points | tick_data::party_loyalty | tick_data::politics
+				| tick_data::flashpoints | tick_data::crisis | tick_data::events),
+			tick_data::armies | tick_data::navies | tick_data::dig_in | tick_data::provinces | tick_data::ai);
+		// executes the effects of the decisions taken
+		r.add("ai::take_ai_decisions", [](sys::state& s) { ai::take_ai_decisions(s); },
+			tick_data_set::everything(),
+			tick_data_set::everything());
+
+		r.finalize();
+		return r;
+	}();
+	return g;
+}
+
 void state::single_game_tick() {
 	// do update logic
 
@@ -3915,6 +4161,13 @@ void state::single_game_tick() {
 
 	auto ymd_date = current_date.to_ymd(start_date);
 
+	static auto const tick_phase = profiler::register_phase("single_game_tick");
+	profiler::scope tick_ps{ tick_phase };
+
+	// the tick changes nearly everything the budget estimates depend on
+	economy::invalidate_budget_projections(*this);
+	economy::invalidate_factory_type_scores(*this);
+
 	diplomatic_message::update_pending(*this);
 
 	auto month_start = sys::year_month_day{ ymd_date.year, ymd_date.month, uint16_t(1) };
@@ -3939,6 +4192,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::update_ideologies");
+			profiler::scope ps{ phase };
 			demographics::update_ideologies(*this, o, days_in_month, idbuf);
 			break;
 		}
@@ -3947,6 +4202,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day + 1);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::update_issues");
+			profiler::scope ps{ phase };
 			demographics::update_issues(*this, o, days_in_month, isbuf);
 			break;
 		}
@@ -3955,6 +4212,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day + 6);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::update_type_changes");
+			profiler::scope ps{ phase };
 			demographics::update_type_changes(*this, o, days_in_month, pbuf);
 			break;
 		}
@@ -3963,6 +4222,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day + 7);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::update_assimilation");
+			profiler::scope ps{ phase };
 			demographics::update_assimilation(*this, o, days_in_month, abuf);
 			break;
 		}
@@ -3971,6 +4232,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day + 8);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::update_internal_migration");
+			profiler::scope ps{ phase };
 			demographics::update_internal_migration(*this, o, days_in_month, mbuf);
 			break;
 		}
@@ -3979,6 +4242,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day + 9);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::update_colonial_migration");
+			profiler::scope ps{ phase };
 			demographics::update_colonial_migration(*this, o, days_in_month, cmbuf);
 			break;
 		}
@@ -3987,6 +4252,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day + 10);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::update_immigration");
+			profiler::scope ps{ phase };
 			demographics::update_immigration(*this, o, days_in_month, imbuf);
 			break;
 		}
@@ -4003,6 +4270,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day + 0);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::apply_ideologies");
+			profiler::scope ps{ phase };
 			demographics::apply_ideologies(*this, o, days_in_month, idbuf);
 			break;
 		}
@@ -4011,6 +4280,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day + 1);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::apply_issues");
+			profiler::scope ps{ phase };
 			demographics::apply_issues(*this, o, days_in_month, isbuf);
 			break;
 		}
@@ -4019,6 +4290,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day + 2);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::update_militancy");
+			profiler::scope ps{ phase };
 			demographics::update_militancy(*this, o, days_in_month);
 			break;
 		}
@@ -4027,6 +4300,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day + 3);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::update_consciousness");
+			profiler::scope ps{ phase };
 			demographics::update_consciousness(*this, o, days_in_month);
 			break;
 		}
@@ -4035,6 +4310,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day + 4);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::update_literacy");
+			profiler::scope ps{ phase };
 			demographics::update_literacy(*this, o, days_in_month);
 			break;
 		}
@@ -4043,6 +4320,8 @@ void state::single_game_tick() {
 			auto o = uint32_t(ymd_date.day + 5);
 			if(o >= days_in_month)
 				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::update_growth");
+			profiler::scope ps{ phase };
 			demographics::update_growth(*this, o, days_in_month);
 			break;
 		}
@@ -4059,281 +4338,129 @@ void state::single_game_tick() {
 		}
 	});
 
-	// because they may add pops, these changes must be applied sequentially
-	{
-		auto o = uint32_t(ymd_date.day + 6);
-		if(o >= days_in_month)
-			o -= days_in_month;
-		demographics::apply_type_changes(*this, o, days_in_month, pbuf);
-	}
-	{
-		auto o = uint32_t(ymd_date.day + 7);
-		if(o >= days_in_month)
-			o -= days_in_month;
-		demographics::apply_assimilation(*this, o, days_in_month, abuf);
-	}
-	{
-		auto o = uint32_t(ymd_date.day + 8);
-		if(o >= days_in_month)
-			o -= days_in_month;
-		demographics::apply_internal_migration(*this, o, days_in_month, mbuf);
+	// ideologies, issues and growth changed the pops of these blocks; the multiplayer daily demographics update sums their
+	// provinces again (the single player one doesn't look at the marks)
+	if(network_mode != network_mode_type::single_player) {
+		for(uint32_t shift : { 0u, 1u, 5u }) {
+			auto o = uint32_t(ymd_date.day + shift);
+			if(o >= days_in_month)
+				o -= days_in_month;
+			demographics::mark_changed_pops(*this, o, days_in_month);
+		}
 	}
+
+	// these changes may add pops, so they are gathered in parallel and then applied in a fixed order
+	static demographics::pop_transfer_list transfers[5];
+	concurrency::parallel_for(0, 5, [&](int32_t index) {
+		switch(index) {
+		case 0:
+		{
+			auto o = uint32_t(ymd_date.day + 6);
+			if(o >= days_in_month)
+				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::gather_type_changes");
+			profiler::scope ps{ phase };
+			demographics::gather_type_changes(*this, o, days_in_month, pbuf, transfers[0]);
+			break;
+		}
+		case 1:
+		{
+			auto o = uint32_t(ymd_date.day + 7);
+			if(o >= days_in_month)
+				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::gather_assimilation");
+			profiler::scope ps{ phase };
+			demographics::gather_assimilation(*this, o, days_in_month, abuf, transfers[1]);
+			break;
+		}
+		case 2:
+		{
+			auto o = uint32_t(ymd_date.day + 8);
+			if(o >= days_in_month)
+				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::gather_internal_migration");
+			profiler::scope ps{ phase };
+			demographics::gather_internal_migration(*this, o, days_in_month, mbuf, transfers[2]);
+			break;
+		}
+		case 3:
+		{
+			auto o = uint32_t(ymd_date.day + 9);
+			if(o >= days_in_month)
+				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::gather_colonial_migration");
+			profiler::scope ps{ phase };
+			demographics::gather_colonial_migration(*this, o, days_in_month, cmbuf, transfers[3]);
+			break;
+		}
+		case 4:
+		{
+			auto o = uint32_t(ymd_date.day + 10);
+			if(o >= days_in_month)
+				o -= days_in_month;
+			static auto const phase = profiler::register_phase("demographics::gather_immigration");
+			profiler::scope ps{ phase };
+			demographics::gather_immigration(*this, o, days_in_month, imbuf, transfers[4]);
+			break;
+		}
+		default:
+			break;
+		}
+	});
 	{
-		auto o = uint32_t(ymd_date.day + 9);
-		if(o >= days_in_month)
-			o -= days_in_month;
-		demographics::apply_colonial_migration(*this, o, days_in_month, cmbuf);
+		static auto const phase = profiler::register_phase("demographics::apply_pop_transfers");
+		profiler::scope ps{ phase };
+		demographics::apply_pop_transfers(*this, transfers, 5);
 	}
+
 	{
-		auto o = uint32_t(ymd_date.day + 10);
-		if(o >= days_in_month)
-			o -= days_in_month;
-		demographics::apply_immigration(*this, o, days_in_month, imbuf);
+		static auto const phase = profiler::register_phase("demographics::remove_size_zero_pops");
+		profiler::scope ps{ phase };
+		demographics::remove_size_zero_pops(*this);
 	}
 
-	demographics::remove_size_zero_pops(*this);
-
 	// basic repopulation of demographics derived values
 
 	int64_t pc_difference = 0;
 
-	if(network_mode != network_mode_type::single_player)
+	// the sums are combined in fixed point, so they come out the same on every machine no matter how the work is split
+	// between threads; it still has to finish before the tick reads the demographics, unlike the single player version
+	if(network_mode != network_mode_type::single_player) {
+		static auto const phase = profiler::register_phase("demographics::regenerate_from_pop_data_daily");
+		profiler::scope ps{ phase };
 		demographics::regenerate_from_pop_data_daily(*this);
+	}
 
 	//
 	// ALTERNATE PAR DEMO START POINT A
 	//
 
 	concurrency::parallel_invoke([&]() {
-		// values updates pass 1 (mostly trivial things, can be done in parallel)
-		concurrency::parallel_for(0, 15, [&](int32_t index) {
-			switch(index) {
-			case 0:
-				ai::refresh_home_ports(*this);
-				break;
-			case 1:
-				// Instant research cheat
-				for(auto n : this->cheat_data.instant_research_nations) {
-					auto tech = this->world.nation_get_current_research(n);
-					if(tech.is_valid()) {
-						float points = culture::effective_technology_rp_cost(*this, this->current_date.to_ymd(this->start_date).year, n, tech);
-						this->world.nation_set_research_points(n, points);
-					}
-				}
-				nations::update_research_points(*this);
-				break;
-			case 2:
-				military::regenerate_land_unit_average(*this);
-				break;
-			case 3:
-				military::regenerate_ship_scores(*this);
-				break;
-			case 4:
-				military::update_naval_supply_points(*this);
-				break;
-			case 5:
-				military::update_all_recruitable_regiments(*this);
-				break;
-			case 6:
-				military::regenerate_total_regiment_counts(*this);
-				break;
-			case 7:
-				economy::update_factory_employment(*this);
-				break;
-			case 8:
-				nations::update_administrative_efficiency(*this);
-				rebel::daily_update_rebel_organization(*this);
-				break;
-			case 9:
-				military::daily_leaders_update(*this);
-				break;
-			case 10:
-				politics::daily_party_loyalty_update(*this);
-				break;
-			case 11:
-				nations::daily_update_flashpoint_tension(*this);
-				break;
-			case 12:
-				military::update_ticking_war_score(*this);
-				break;
-			case 13:
-				military::increase_dig_in(*this);
-				break;
-			case 14:
-				military::update_blockade_status(*this);
-				break;
-			}
-		});
-
-		economy::daily_update(*this, false, 1.f);
-
-		//
-		// ALTERNATE PAR DEMO START POINT B
-		//
-
-		military::recover_org(*this);
-		military::update_siege_progress(*this);
-		military::update_movement(*this);
-		military::update_naval_battles(*this);
-		military::update_land_battles(*this);
-
-		military::advance_mobilizations(*this);
-
-		province::update_colonization(*this);
-		military::update_cbs(*this); // may add/remove cbs to a nation
-
-		event::update_events(*this);
-
-		culture::update_research(*this, uint32_t(ymd_date.year));
-
-		nations::update_industrial_scores(*this);
-		nations::update_military_scores(*this); // depends on ship score, land unit average
-		nations::update_rankings(*this);				// depends on industrial score, military scores
-		nations::update_great_powers(*this);		// depends on rankings
-		nations::update_influence(*this);				// depends on rankings, great powers
-
-		nations::update_crisis(*this);
-		politics::update_elections(*this);
-
-		if(current_date.value % 4 == 0) {
-			ai::update_ai_colonial_investment(*this);
-		}
-
-		if(defines.alice_eval_ai_mil_everyday != 0.0f) {
-			ai::make_defense(*this);
-			ai::make_attacks(*this);
-			ai::update_ships(*this);
-		}
-		ai::take_ai_decisions(*this);
+		daily_tick_graph().run(*this);
 
 		// Once per month updates, spread out over the month
-		switch(ymd_date.day) {
-		case 1:
-			nations::update_monthly_points(*this);
-			economy::prune_factories(*this);
-			break;
-		case 2:
-			province::update_blockaded_cache(*this);
-			sys::update_modifier_effects(*this);
-			break;
-		case 3:
-			military::monthly_leaders_update(*this);
-			ai::add_gw_goals(*this);
-			break;
-		case 4:
-			military::reinforce_regiments(*this);
-			if(!bool(defines.alice_eval_ai_mil_everyday)) {
-				ai::make_defense(*this);
-			}
-			break;
-		case 5:
-			rebel::update_movements(*this);
-			rebel::update_factions(*this);
-			break;
-		case 6:
-			ai::form_alliances(*this);
-			if(!bool(defines.alice_eval_ai_mil_everyday)) {
-				ai::make_attacks(*this);
-			}
-			break;
-		case 7:
-			ai::update_ai_general_status(*this);
-			break;
-		case 8:
-			military::apply_attrition(*this);
-			break;
-		case 9:
-			military::repair_ships(*this);
-			break;
-		case 10:
-			province::update_crimes(*this);
-			break;
-		case 11:
-			province::update_nationalism(*this);
-			break;
-		case 12:
-			ai::update_ai_research(*this);
-			rebel::update_armies(*this);
-			rebel::rebel_hunting_check(*this);
-			break;
-		case 13:
-			ai::perform_influence_actions(*this);
-			break;
-		case 14:
-			ai::update_focuses(*this);
-			break;
-		case 15:
-			culture::discover_inventions(*this);
-			break;
-		case 16:
-			ai::build_ships(*this);
-			break;
-		case 17:
-			ai::update_land_constructions(*this);
-			break;
-		case 18:
-			ai::update_ai_econ_construction(*this);
-			break;
-		case 19:
-			ai::update_budget(*this);
-			break;
-		case 20:
-			nations::monthly_flashpoint_update(*this);
-			if(!bool(defines.alice_eval_ai_mil_everyday)) {
-				ai::make_defense(*this);
-			}
-			break;
-		case 21:
-			ai::update_ai_colony_starting(*this);
-			break;
-		case 22:
-			ai::take_reforms(*this);
-			break;
-		case 23:
-			ai::civilize(*this);
-			ai::make_war_decs(*this);
-			break;
-		case 24:
-			rebel::execute_rebel_victories(*this);
-			if(!bool(defines.alice_eval_ai_mil_everyday)) {
-				ai::make_attacks(*this);
-			}
-			rebel::update_armies(*this);
-			rebel::rebel_hunting_check(*this);
-			break;
-		case 25:
-			rebel::execute_province_defections(*this);
-			break;
-		case 26:
-			ai::make_peace_offers(*this);
-			break;
-		case 27:
-			ai::update_crisis_leaders(*this);
-			break;
-		case 28:
-			rebel::rebel_risings_check(*this);
-			break;
-		case 29:
-			ai::update_war_intervention(*this);
-			break;
-		case 30:
-			if(!bool(defines.alice_eval_ai_mil_everyday)) {
-				ai::update_ships(*this);
-			}
-			rebel::update_armies(*this);
-			rebel::rebel_hunting_check(*this);
-			break;
-		case 31:
-			ai::update_cb_fabrication(*this);
-			ai::update_ai_ruling_party(*this);
-			break;
-		default:
-			break;
+		static auto const monthly_phases = []() {
+			std::array<profiler::phase_id, 32> r{};
+			for(uint32_t i = 1; i < r.size(); ++i)
+				r[i] = profiler::register_phase("monthly updates, day " + std::to_string(i));
+			return r;
+		}();
+		{
+			profiler::scope monthly_ps{ monthly_phases[ymd_date.day] };
+			if(monthly_jobs.size() == 0)
+				add_monthly_jobs(monthly_jobs);
+			bool use_measurements = adaptive_monthly_schedule && network_mode == sys::network_mode_type::single_player;
+			if(ymd_date.day == 1 || !monthly_jobs.is_planned_for(days_in_month, use_measurements))
+				monthly_jobs.plan(days_in_month, use_measurements, world.nation_size());
+			monthly_jobs.run_day(*this, ymd_date.day, use_measurements);
 		}
 
 		military::apply_regiment_damage(*this);
 
 		if(ymd_date.day == 1) {
+			static auto const phase = profiler::register_phase("first of the month updates");
+			profiler::scope ps{ phase };
+
 			if(ymd_date.month == 1) {
 				// yearly update : redo the upper house
 				for(auto n : world.in_nation) {
@@ -4399,8 +4526,14 @@ void state::single_game_tick() {
 			}
 		}
 
-		ai::general_ai_unit_tick(*this);
+		{
+			static auto const phase = profiler::register_phase("ai::general_ai_unit_tick");
+			profiler::scope ps{ phase };
+			ai::general_ai_unit_tick(*this);
+		}
 
+		static auto const cleanup_phase = profiler::register_phase("end of day cleanup and cached values");
+		profiler::scope cleanup_ps{ cleanup_phase };
 		military::run_gc(*this);
 		nations::run_gc(*this);
 		military::update_blackflag_status(*this);
@@ -4412,8 +4545,11 @@ void state::single_game_tick() {
 
 	},
 	[&]() {
-		if(network_mode == network_mode_type::single_player)
+		if(network_mode == network_mode_type::single_player) {
+			static auto const phase = profiler::register_phase("demographics::alt_regenerate_from_pop_data_daily");
+			profiler::scope ps{ phase };
 			demographics::alt_regenerate_from_pop_data_daily(*this);
+		}
 	}
 	);
 
@@ -4429,6 +4565,9 @@ void state::single_game_tick() {
 	 * END OF DAY: update cached data
 	 */
 
+	static auto const records_phase = profiler::register_phase("end of day records");
+	profiler::scope records_ps{ records_phase };
+
 	player_data_cache.treasury_record[current_date.value % 32] = nations::get_treasury(*this, local_player_nation);
 	player_data_cache.population_record[current_date.value % 32] = world.nation_get_demographics(local_player_nation, demographics::total);
 	if((current_date.value % 16) == 0) {
@@ -4445,9 +4584,22 @@ void state::single_game_tick() {
 		}
 	}
 
+	economy_history::append_day(*this);
+
+	records_ps.end();
+
+	// the projections only serve the ui, so during a turbo batch the game loop rebuilds them once the ui is told about it
+	if(!defer_ui_update) {
+		static auto const phase = profiler::register_phase("economy::update_budget_projections");
+		profiler::scope ps{ phase };
+		economy::update_budget_projections(*this);
+	}
+
 	ui_date = current_date;
+	ui_snapshot::take(*this);
 
-	game_state_updated.store(true, std::memory_order::release);
+	if(!defer_ui_update)
+		game_state_updated.store(true, std::memory_order::release);
 
 	switch(user_settings.autosaves) {
 	case autosave_frequency::none:
@@ -4546,6 +4698,13 @@ void state::debug_scenario_oos_dump() {
 	}
 }
 
+// While fast forwarding in turbo mode the ui only processes its queues when it is told that the game state was updated.
+// Anything the player has to respond to, or a message queue that is about to overflow, ends the batch early.
+static bool turbo_needs_ui_update(sys::state& state) {
+	return !state.new_n_event.empty() || !state.new_f_n_event.empty() || !state.new_p_event.empty() || !state.new_f_p_event.empty()
+		|| !state.new_requests.empty() || state.new_messages.size() * 2 >= state.new_messages.capacity();
+}
+
 void state::game_loop() {
 	static int32_t game_speed[] = {
 		0,		// speed 0
@@ -4559,6 +4718,10 @@ void state::game_loop() {
 	game_speed[3] = int32_t(defines.alice_speed_3);
 	game_speed[4] = int32_t(defines.alice_speed_4);
 
+	// turbo mode: days simulated since the ui was last told to refresh
+	int32_t turbo_days_pending = 0;
+	auto last_ui_update = std::chrono::steady_clock::now();
+
 	while(quit_signaled.load(std::memory_order::acquire) == false) {
 		network::send_and_receive_commands(*this);
 		{
@@ -4575,6 +4738,14 @@ void state::game_loop() {
 			}
 
 			if(speed <= 0 || upause || internally_paused || current_scene.enforced_pause) {
+				if(turbo_days_pending != 0) {
+					turbo_days_pending = 0;
+					{
+						std::lock_guard l{ ugly_ui_game_interaction_hack };
+						economy::update_budget_projections(*this);
+					}
+					game_state_updated.store(true, std::memory_order::release);
+				}
 				std::this_thread::sleep_for(std::chrono::milliseconds(15));
 			} else {
 				auto entry_time = std::chrono::steady_clock::now();
@@ -4583,9 +4754,44 @@ void state::game_loop() {
 					last_update = entry_time;
 					if(network_mode == sys::network_mode_type::host) {
 						command::advance_tick(*this, local_player_nation);
+					} else if(speed >= 5 && turbo_fast_forward.load(std::memory_order::acquire)) {
+						// run several days per lock, and only let the ui rebuild itself every so many days (or ms)
+						auto const batch_size = std::max(1, int32_t(defines.alice_turbo_ticks_per_batch));
+						auto const days_per_update = std::max(1, int32_t(defines.alice_turbo_days_per_ui_update));
+						auto const ms_per_update = int64_t(defines.alice_turbo_ms_per_ui_update);
+
+						std::lock_guard l{ ugly_ui_game_interaction_hack };
+						defer_ui_update = true;
+						for(int32_t i = 0; i < batch_size; ++i) {
+							single_game_tick();
+							++turbo_days_pending;
+
+							if(internally_paused || current_scene.enforced_pause || turbo_needs_ui_update(*this)
+								|| quit_signaled.load(std::memory_order::acquire)
+								|| actual_game_speed.load(std::memory_order::acquire) < 5
+								|| !turbo_fast_forward.load(std::memory_order::acquire)
+								|| ui_pause.load(std::memory_order::acquire)) {
+								break;
+							}
+							command::execute_pending_commands(*this);
+							if(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - entry_time).count() >= ms_per_update)
+								break;
+						}
+						defer_ui_update = false;
+
+						auto now = std::chrono::steady_clock::now();
+						if(turbo_days_pending >= days_per_update || turbo_needs_ui_update(*this) || internally_paused
+							|| std::chrono::duration_cast<std::chrono::milliseconds>(now - last_ui_update).count() >= ms_per_update) {
+							turbo_days_pending = 0;
+							last_ui_update = now;
+							economy::update_budget_projections(*this);
+							game_state_updated.store(true, std::memory_order::release);
+						}
 					} else {
 						std::lock_guard l{ ugly_ui_game_interaction_hack };
 						single_game_tick();
+						turbo_days_pending = 0;
+						last_ui_update = entry_time;
 					}
 				} else {
 					std::this_thread::sleep_for(std::chrono::milliseconds(1));
@@ -17,6 +17,8 @@
 #include "sound.hpp"
 #include "map_state.hpp"
 #include "economy.hpp"
+#include "economy_history.hpp"
+#include "economy_telemetry.hpp"
 #include "culture.hpp"
 #include "military.hpp"
 #include "nations.hpp"
@@ -32,6 +34,8 @@
 #include "network.hpp"
 #include "fif.hpp"
 #include "immediate_mode.hpp"
+#include "tick_graph.hpp"
+#include "ui_snapshot.hpp"
 
 // this header will eventually contain the highest-level objects
 // that represent the overall state of the program
@@ -421,12 +425,7 @@ struct cheat_data_s {
 	bool province_names = false;
 
 	bool ecodump = false;
-
-	std::string national_economy_dump_buffer;
-	std::string savings_buffer;
-	std::string prices_dump_buffer;
-	std::string demand_dump_buffer;
-	std::string supply_dump_buffer;
+	economy_telemetry::sink ecodump_sink; // see economy_telemetry.hpp
 
 	bool instant_navy = false;
 	bool always_allow_decisions = false;
@@ -482,6 +481,22 @@ struct player_data { // currently this data is serialized via memcpy, to make su
 /// <summary>
 /// Holds important data about the game world, state, and other data regarding windowing, audio, and more.
 /// </summary>
+// the pops ordered by the index of their province, rebuilt by demographics::update_pop_province_index before the
+// demographics are summed up; pops of province p are pops[province_start[p]] up to pops[province_start[p + 1]]
+struct pop_province_index {
+	std::vector<dcon::pop_id> pops;
+	std::vector<uint32_t> province_start;
+};
+
+// the fixed point province totals of the culture, ideology, issue option and religion demographics keys, kept from one day
+// to the next so that the multiplayer daily update only sums again the provinces marked in changed (see
+// demographics::mark_changed); single player does not use it
+struct extra_demographics_cache {
+	std::vector<int64_t> province_sums; // province * (size - common_size) + key - common_size
+	std::vector<uint8_t> changed; // by province
+	bool valid = false;
+};
+
 struct alignas(64) state { 
 	dcon::data_container world; // Holds data regarding the game world. Also contains user locales.
 
@@ -511,7 +526,15 @@ struct alignas(64) state {
 	ankerl::unordered_dense::map<dcon::text_key, uint32_t, text::vector_backed_ci_hash, text::vector_backed_ci_eq> locale_key_to_text_sequence;
 
 	bool adjacency_data_out_of_date = true;
-	bool national_cached_values_out_of_date = false;
+	bool national_cached_values_out_of_date = false; // forces the cached values of every nation to be recomputed
+	dirty_set<dcon::nation_id> nations_with_changed_provinces;
+	dirty_set<dcon::province_id> provinces_with_changed_owner;
+	economy::active_trade_routes active_trade_routes;
+	pop_province_index pops_by_province;
+	extra_demographics_cache extra_demographics;
+	economy::budget_projection_cache budget_projections;
+	std::vector<economy::factory_type_score> factory_type_scores; // market * factory_type_size + factory type
+	bool factory_type_scores_valid = false;
 	bool diplomatic_cached_values_out_of_date = false;
 	std::vector<dcon::nation_id> nations_by_rank;
 	std::vector<dcon::nation_id> nations_by_industrial_score;
@@ -601,6 +624,7 @@ struct alignas(64) state {
 	uint32_t game_seed = 0; // do *not* alter this value, ever
 	float inflation = 1.0f;
 	player_data player_data_cache;
+	economy_history::store economic_history; // saved with the game, see economy_history.hpp
 	std::vector<dcon::army_id> selected_armies;
 	std::vector<dcon::regiment_id> selected_regiments; // selected regiments inside the army
 
@@ -639,10 +663,13 @@ struct alignas(64) state {
 	std::atomic<bool> save_list_updated = false;                     // game state -> ui signal
 	std::atomic<bool> quit_signaled = false;                         // ui -> game state signal
 	std::atomic<int32_t> actual_game_speed = 0;                      // ui -> game state message
+	std::atomic<bool> turbo_fast_forward = false;                    // ui -> game state: at speed 5, run ticks in batches and refresh the ui less often
 	rigtorp::SPSCQueue<command::payload> incoming_commands;          // ui or network -> local gamestate
 	std::atomic<bool> ui_pause = false;                              // force pause by an important message being open
 	std::atomic<bool> railroad_built = true; // game state -> map
 	std::atomic<bool> update_trade_flow = true;
+	std::atomic<bool> ui_snapshot_enabled = false;                   // ui -> game state: copy what the map modes read after every tick
+	ui_snapshot::triple_buffer ui_snapshot_buffers;                  // game state -> ui, see ui_snapshot.hpp
 
 	// synchronization: notifications from the gamestate to ui
 	rigtorp::SPSCQueue<event::pending_human_n_event> new_n_event;
@@ -657,6 +684,12 @@ struct alignas(64) state {
 	// internal game timer / update logic
 	std::chrono::time_point<std::chrono::steady_clock> last_update = std::chrono::steady_clock::now();
 	bool internally_paused = false; // should NOT be set from the ui context (but may be read)
+	bool defer_ui_update = false; // when set, single_game_tick leaves signalling the ui to the game loop (see turbo_fast_forward)
+	sys::monthly_schedule monthly_jobs;
+	// single player only: balance the monthly jobs by their measured run times. This makes the day each monthly job runs
+	// on depend on how fast this machine ran the previous months, so a single player game replayed from a save may not
+	// take the same course.
+	bool adaptive_monthly_schedule = false;
 
 	// common data for the window
 	int32_t x_size = 0;
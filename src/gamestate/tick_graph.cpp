@@ -0,0 +1,130 @@
+#include "tick_graph.hpp"
+#include "tick_profiler.hpp"
+#include "system_state.hpp"
+
+namespace sys {
+
+void tick_graph::add(std::string_view name, void (*update)(sys::state&), tick_data_set reads, tick_data_set writes) {
+	assert(update);
+	nodes.push_back(tick_node{ name, update, reads, writes });
+	node_phase.push_back(profiler::register_phase(name));
+	finalized = false;
+}
+
+void tick_graph::finalize() {
+	node_level.resize(nodes.size());
+	uint16_t max_level = 0;
+	for(size_t j = 0; j < nodes.size(); ++j) {
+		uint16_t level = 0;
+		for(size_t i = 0; i < j; ++i) {
+			bool conflict = nodes[i].writes.intersects(nodes[j].reads | nodes[j].writes) || nodes[i].reads.intersects(nodes[j].writes);
+			if(conflict)
+				level = std::max(level, uint16_t(node_level[i] + 1));
+		}
+		node_level[j] = level;
+		max_level = std::max(max_level, level);
+	}
+
+	level_order.clear();
+	level_start.clear();
+	if(!nodes.empty()) {
+		for(uint16_t l = 0; l <= max_level; ++l) {
+			level_start.push_back(uint16_t(level_order.size()));
+			for(size_t j = 0; j < nodes.size(); ++j) {
+				if(node_level[j] == l)
+					level_order.push_back(uint16_t(j));
+			}
+		}
+		level_start.push_back(uint16_t(level_order.size()));
+	}
+	finalized = true;
+}
+
+void tick_graph::run(sys::state& state) {
+	if(!finalized)
+		finalize();
+
+	for(size_t l = 0; l + 1 < level_start.size(); ++l) {
+		auto first = int32_t(level_start[l]);
+		auto last = int32_t(level_start[l + 1]);
+		if(last - first == 1) {
+			profiler::scope p{ node_phase[level_order[first]] };
+			nodes[level_order[first]].update(state);
+		} else {
+			concurrency::parallel_for(first, last, [&](int32_t i) {
+				profiler::scope p{ node_phase[level_order[i]] };
+				nodes[level_order[i]].update(state);
+			});
+		}
+	}
+}
+
+void monthly_schedule::add(std::string_view name, void (*update)(sys::state&, uint32_t, uint32_t), float estimated_cost, uint32_t slice_count) {
+	assert(update && slice_count > 0);
+	jobs.push_back(monthly_job{ name, update, estimated_cost, slice_count });
+	job_phase.push_back(profiler::register_phase("monthly: " + std::string(name)));
+	for(uint32_t i = 0; i < slice_count; ++i) {
+		items.push_back(work_item{ uint16_t(jobs.size() - 1), uint16_t(i) });
+		measured_cost.push_back(-1.0f);
+	}
+	planned_days = 0;
+}
+
+void monthly_schedule::plan(uint32_t days_in_month, bool use_measurements, uint32_t nation_count) {
+	assert(days_in_month > 0);
+
+	std::vector<float> costs(items.size());
+	float total = 0.0f;
+	for(size_t i = 0; i < items.size(); ++i) {
+		auto& j = jobs[items[i].job];
+		costs[i] = (use_measurements && measured_cost[i] >= 0.0f) ? measured_cost[i] : j.estimated_cost / float(j.slice_count);
+		total += costs[i];
+	}
+
+	// each item goes to the day that the middle of its cost falls on, which keeps the items in order
+	// and puts about total / days_in_month worth of work on every day
+	day_start.assign(days_in_month + 1, uint16_t(items.size()));
+	float before = 0.0f;
+	uint32_t day = 0;
+	day_start[0] = 0;
+	for(size_t i = 0; i < items.size(); ++i) {
+		auto middle = before + costs[i] * 0.5f;
+		auto target_day = total > 0.0f ? std::min(uint32_t(middle / total * float(days_in_month)), days_in_month - 1) : uint32_t(0);
+		while(day < target_day) {
+			++day;
+			day_start[day] = uint16_t(i);
+		}
+		before += costs[i];
+	}
+	while(day < days_in_month) {
+		++day;
+		day_start[day] = uint16_t(items.size());
+	}
+
+	planned_days = days_in_month;
+	planned_nation_count = nation_count;
+	planned_with_measurements = use_measurements;
+}
+
+void monthly_schedule::run_day(sys::state& state, uint32_t day, bool measure) {
+	if(day == 0 || day > planned_days)
+		return;
+
+	for(auto i = day_start[day - 1]; i < day_start[day]; ++i) {
+		auto const& item = items[i];
+		auto const& j = jobs[item.job];
+		auto start = profiler::now();
+		{
+			profiler::scope p{ job_phase[item.job] };
+			auto first_nation = uint32_t(uint64_t(planned_nation_count) * item.slice / j.slice_count);
+			auto last_nation = uint32_t(uint64_t(planned_nation_count) * (item.slice + 1) / j.slice_count);
+			j.update(state, first_nation, last_nation);
+		}
+		if(measure) {
+			auto ms = float(profiler::now() - start) / 1'000'000.0f;
+			measured_cost[i] = measured_cost[i] < 0.0f ? ms : measured_cost[i] * 0.75f + ms * 0.25f;
+		}
+	}
+}
+
+} // namespace sys
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <stdint.h>
+#include <string_view>
+#include <vector>
+
+namespace sys {
+struct state;
+
+// The parts of the game state that a tick update may read or write. These tags are what the tick graph uses to
+// decide which updates may run at the same time, so they only need to be as fine grained as the updates that share
+// an object (for example, the various per-nation military scores are separate tags because they are produced by
+// separate updates that may all run at once).
+enum class tick_data : uint8_t {
+	pops,
+	demographics,
+	provinces,
+	province_control,			// controllers, sieges
+	province_ownership,		// owners, colonization, state membership
+	blockades,
+	nations,							// assorted per-nation values: prestige, infamy, war exhaustion, leadership points, ...
+	national_modifiers,
+	administration,				// administrative efficiency
+	research,							// active technologies and inventions, current research
+	research_points,
+	land_unit_scores,
+	ship_scores,
+	naval_supply,
+	recruitable_regiments,
+	regiment_counts,
+	national_scores,			// industrial / military scores, ranks, great powers
+	politics,							// parties, elections, upper house, reforms
+	party_loyalty,
+	rebels,
+	diplomacy,						// relations, influence, spheres, alliances, subjects
+	flashpoints,
+	wars,									// wars, war participants, war goals, cbs
+	war_score,
+	crisis,
+	armies,								// armies, regiments, land battles
+	leaders,
+	dig_in,
+	navies,								// navies, ships, naval battles
+	markets,
+	factories,
+	events,
+	ai,
+	count
+};
+static_assert(uint32_t(tick_data::count) <= 64);
+
+struct tick_data_set {
+	uint64_t bits = 0;
+
+	constexpr tick_data_set() noexcept = default;
+	constexpr tick_data_set(tick_data d) noexcept : bits(uint64_t(1) << uint32_t(d)) { }
+
+	constexpr tick_data_set operator|(tick_data_set o) const noexcept {
+		tick_data_set r;
+		r.bits = bits | o.bits;
+		return r;
+	}
+	constexpr bool intersects(tick_data_set o) const noexcept {
+		return (bits & o.bits) != 0;
+	}
+	constexpr tick_data_set without(tick_data_set o) const noexcept {
+		tick_data_set r;
+		r.bits = bits & ~o.bits;
+		return r;
+	}
+	// for updates that may do anything (running effects, firing events, changing province owners, ...)
+	static constexpr tick_data_set everything() noexcept {
+		tick_data_set r;
+		r.bits = (uint64_t(1) << uint32_t(tick_data::count)) - 1;
+		return r;
+	}
+};
+constexpr tick_data_set operator|(tick_data a, tick_data b) noexcept {
+	return tick_data_set(a) | tick_data_set(b);
+}
+
+struct tick_node {
+	std::string_view name;
+	void (*update)(sys::state&) = nullptr;
+	tick_data_set reads;
+	tick_data_set writes;
+};
+
+// A declarative list of the updates that make up (part of) a game tick.
+// Nodes are added in the order they would run serially. Two nodes conflict when one writes something that the other
+// reads or writes; a node waits for every earlier node it conflicts with, and otherwise is free to run alongside its
+// neighbours. Since conflicting nodes always run in the order they were added, the results are exactly those of
+// running the nodes one after another, which keeps the tick deterministic.
+class tick_graph {
+	std::vector<tick_node> nodes;
+	std::vector<uint16_t> node_phase;         // profiler phase of each node
+	std::vector<uint16_t> node_level;         // nodes in the same level never conflict
+	std::vector<uint16_t> level_order;        // node indices sorted by level
+	std::vector<uint16_t> level_start;        // offsets into level_order, one past the end for the last level
+	bool finalized = false;
+
+public:
+	void add(std::string_view name, void (*update)(sys::state&), tick_data_set reads, tick_data_set writes);
+	// computes the dependencies between nodes; called automatically by the first run
+	void finalize();
+	void run(sys::state& state);
+
+	size_t size() const {
+		return nodes.size();
+	}
+	tick_node const& node(size_t i) const {
+		return nodes[i];
+	}
+	// the number of waves that the nodes are scheduled into; 1 means everything can run at once
+	size_t level_count() const {
+		return level_start.empty() ? 0 : level_start.size() - 1;
+	}
+};
+
+// the daily part of single_game_tick (see system_state.cpp)
+tick_graph& daily_tick_graph();
+
+struct monthly_job {
+	std::string_view name;
+	// a sliced job gets the range of nation indices [first_nation, last_nation) of its slice; jobs that aren't sliced get every nation
+	void (*update)(sys::state&, uint32_t first_nation, uint32_t last_nation) = nullptr;
+	float estimated_cost = 1.0f; // rough milliseconds for the whole job, used until (or instead of) measured times
+	uint32_t slice_count = 1;    // per-nation jobs may be cut into slices that run on different days
+};
+
+// The updates that run once a month. Jobs (or their slices) keep the order they were added in, and are spread over
+// the days of the month so that each day gets about the same amount of work. The plan only depends on the number of
+// days in the month, the number of nations and the job costs: the estimated costs are fixed, so the plan is the same
+// everywhere. The nation count is fixed by the plan, so the slices of a job cover each nation once even if nations are
+// created during the month (those wait for the next month). In single player the measured times of the jobs may be
+// used instead, which balances the month better on the machine at hand but makes which day a job runs on depend on
+// timing.
+class monthly_schedule {
+	struct work_item {
+		uint16_t job = 0;
+		uint16_t slice = 0;
+	};
+
+	std::vector<monthly_job> jobs;
+	std::vector<uint16_t> job_phase;      // profiler phase of each job
+	std::vector<float> measured_cost;     // per slice, in milliseconds; negative until measured
+	std::vector<work_item> items;         // all slices of all jobs, in order
+	std::vector<uint16_t> day_start;      // offsets into items, one past the end for the last day
+	uint32_t planned_days = 0;
+	uint32_t planned_nation_count = 0;
+	bool planned_with_measurements = false;
+
+public:
+	void add(std::string_view name, void (*update)(sys::state&, uint32_t, uint32_t), float estimated_cost, uint32_t slice_count = 1);
+	// spreads the jobs over the days of the month and cuts the sliced jobs into ranges of nation_count nations
+	void plan(uint32_t days_in_month, bool use_measurements, uint32_t nation_count);
+	// runs the jobs of one day of the month (1 based); if measure is true, their run times are recorded for later plans
+	void run_day(sys::state& state, uint32_t day, bool measure);
+
+	bool is_planned_for(uint32_t days_in_month, bool use_measurements) const {
+		return planned_days == days_in_month && planned_with_measurements == use_measurements;
+	}
+	size_t size() const {
+		return jobs.size();
+	}
+};
+
+// fills in the monthly part of single_game_tick (see system_state.cpp)
+void add_monthly_jobs(monthly_schedule& schedule);
+
+} // namespace sys
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <webapi/json.hpp>
+#include "tick_profiler.hpp"
+
+namespace profiler {
+
+struct thread_buffer {
+	std::atomic<uint64_t> head = 0; // total number of samples ever written; only the owning thread writes it
+	uint32_t thread_index = 0;
+	std::array<sample, samples_per_thread> data;
+};
+
+static std::atomic<bool> enabled = false;
+static std::atomic<int64_t> cleared_before = 0;
+static std::atomic<thread_buffer*> buffers[max_threads];
+static std::atomic<uint32_t> buffer_count = 0;
+static thread_local thread_buffer* local_buffer = nullptr;
+static thread_local bool no_buffer_available = false;
+
+static std::mutex phase_lock;
+static std::array<std::string, max_phases> phase_names;
+static std::atomic<uint32_t> phase_count = 0;
+
+static auto const epoch = std::chrono::steady_clock::now();
+
+phase_id register_phase(std::string_view name) {
+	std::lock_guard l{ phase_lock };
+	auto count = phase_count.load(std::memory_order::relaxed);
+	for(uint32_t i = 0; i < count; ++i) {
+		if(phase_names[i] == name)
+			return phase_id(i);
+	}
+	assert(count < max_phases);
+	if(count >= max_phases)
+		return phase_id(max_phases - 1);
+	phase_names[count] = std::string(name);
+	phase_count.store(count + 1, std::memory_order::release);
+	return phase_id(count);
+}
+
+std::string_view phase_name(phase_id id) {
+	if(id < phase_count.load(std::memory_order::acquire))
+		return phase_names[id];
+	return std::string_view{};
+}
+
+void set_enabled(bool v) {
+	enabled.store(v, std::memory_order::release);
+}
+bool is_enabled() {
+	return enabled.load(std::memory_order::relaxed);
+}
+
+int64_t now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void record(phase_id phase, int64_t start, int64_t end) {
+	auto b = local_buffer;
+	if(!b) {
+		if(no_buffer_available)
+			return;
+		auto index = buffer_count.fetch_add(1, std::memory_order::acq_rel);
+		if(index >= max_threads) {
+			no_buffer_available = true;
+			return;
+		}
+		b = new thread_buffer();
+		b->thread_index = index;
+		buffers[index].store(b, std::memory_order::release);
+		local_buffer = b;
+	}
+	auto h = b->head.load(std::memory_order::relaxed);
+	b->data[h & (samples_per_thread - 1)] = sample{ start, end, phase };
+	b->head.store(h + 1, std::memory_order::release);
+}
+
+void clear() {
+	cleared_before.store(now(), std::memory_order::release);
+}
+
+std::vector<sample> collect(std::vector<uint32_t>* thread_of_sample) {
+	std::vector<sample> result;
+	std::vector<sample> copy;
+	auto cutoff = cleared_before.load(std::memory_order::acquire);
+	auto count = std::min(buffer_count.load(std::memory_order::acquire), max_threads);
+
+	for(uint32_t t = 0; t < count; ++t) {
+		auto b = buffers[t].load(std::memory_order::acquire);
+		if(!b)
+			continue;
+
+		auto h1 = b->head.load(std::memory_order::acquire);
+		auto first = h1 > samples_per_thread ? h1 - samples_per_thread : uint64_t(0);
+		copy.clear();
+		for(auto i = first; i < h1; ++i)
+			copy.push_back(b->data[i & (samples_per_thread - 1)]);
+
+		// the owner keeps writing while we copy: anything it may have overwritten in the meantime is dropped
+		std::atomic_thread_fence(std::memory_order::acquire);
+		auto h2 = b->head.load(std::memory_order::relaxed);
+		auto valid_from = h2 >= samples_per_thread ? h2 - samples_per_thread + 1 : uint64_t(0);
+
+		for(auto i = std::max(first, valid_from); i < h1; ++i) {
+			auto& s = copy[size_t(i - first)];
+			if(s.start < cutoff)
+				continue;
+			result.push_back(s);
+			if(thread_of_sample)
+				thread_of_sample->push_back(b->thread_index);
+		}
+	}
+	return result;
+}
+
+std::string chrome_trace_json() {
+	using json = nlohmann::json;
+	std::vector<uint32_t> threads;
+	auto samples = collect(&threads);
+
+	json events = json::array();
+	auto count = std::min(buffer_count.load(std::memory_order::acquire), max_threads);
+	for(uint32_t t = 0; t < count; ++t) {
+		events.push_back(json{ { "name", "thread_name" }, { "ph", "M" }, { "pid", 1 }, { "tid", t },
+			{ "args", json{ { "name", "thread " + std::to_string(t) } } } });
+	}
+	for(size_t i = 0; i < samples.size(); ++i) {
+		events.push_back(json{ { "name", std::string(phase_name(samples[i].phase)) }, { "cat", "tick" }, { "ph", "X" }, { "pid", 1 },
+			{ "tid", threads[i] }, { "ts", double(samples[i].start) / 1000.0 }, { "dur", double(samples[i].end - samples[i].start) / 1000.0 } });
+	}
+	json out = json{ { "displayTimeUnit", "ms" }, { "traceEvents", std::move(events) } };
+	return out.dump() + "\n";
+}
+
+std::vector<phase_summary> summarize() {
+	return summarize(collect());
+}
+
+std::vector<phase_summary> summarize(std::vector<sample> const& samples) {
+	auto count = phase_count.load(std::memory_order::acquire);
+
+	std::vector<std::vector<int64_t>> durations(count);
+	for(auto& s : samples) {
+		if(s.phase < count)
+			durations[s.phase].push_back(s.end - s.start);
+	}
+
+	std::vector<phase_summary> result;
+	for(uint32_t i = 0; i < count; ++i) {
+		auto& d = durations[i];
+		if(d.empty())
+			continue;
+		std::sort(d.begin(), d.end());
+
+		phase_summary ps;
+		ps.name = std::string(phase_name(phase_id(i)));
+		ps.count = uint32_t(d.size());
+		int64_t total = 0;
+		for(auto v : d)
+			total += v;
+		auto p99_index = std::min(d.size() - 1, size_t(std::ceil(double(d.size()) * 0.99)) - 1);
+		ps.min_ms = double(d.front()) / 1'000'000.0;
+		ps.max_ms = double(d.back()) / 1'000'000.0;
+		ps.p99_ms = double(d[p99_index]) / 1'000'000.0;
+		ps.total_ms = double(total) / 1'000'000.0;
+		ps.mean_ms = ps.total_ms / double(d.size());
+		result.push_back(std::move(ps));
+	}
+	std::sort(result.begin(), result.end(), [](phase_summary const& a, phase_summary const& b) {
+		return a.total_ms > b.total_ms;
+	});
+	return result;
+}
+
+std::string summary_text() {
+	auto rows = summarize();
+	std::string out;
+	char buffer[512];
+	std::snprintf(buffer, sizeof(buffer), "%-48s %8s %10s %10s %10s %10s %12s\n", "phase", "count", "min ms", "mean ms", "p99 ms", "max ms", "total ms");
+	out += buffer;
+	for(auto& r : rows) {
+		std::snprintf(buffer, sizeof(buffer), "%-48.48s %8u %10.3f %10.3f %10.3f %10.3f %12.3f\n", r.name.c_str(), r.count, r.min_ms, r.mean_ms, r.p99_ms, r.max_ms, r.total_ms);
+		out += buffer;
+	}
+	return out;
+}
+
+} // namespace profiler
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Built-in timing of the phases of the game tick.
+// Each thread that records a sample gets its own ring buffer that only it writes to, so recording never takes a lock.
+// The buffers keep the most recent samples of each thread; dumping reads them without stopping the game thread, so
+// the trace and the summary always describe a rolling window of recent ticks.
+
+namespace profiler {
+
+using phase_id = uint16_t;
+
+struct sample {
+	int64_t start = 0; // nanoseconds since the profiler epoch
+	int64_t end = 0;
+	phase_id phase = 0;
+};
+
+struct phase_summary {
+	std::string name;
+	uint32_t count = 0;
+	double min_ms = 0.0;
+	double mean_ms = 0.0;
+	double p99_ms = 0.0;
+	double max_ms = 0.0;
+	double total_ms = 0.0;
+};
+
+inline constexpr uint32_t samples_per_thread = 1 << 13; // must be a power of two
+inline constexpr uint32_t max_threads = 256;
+inline constexpr uint32_t max_phases = 1024;
+
+// returns the same id every time it is called with the same name; call sites are expected to cache the result
+phase_id register_phase(std::string_view name);
+std::string_view phase_name(phase_id id);
+
+void set_enabled(bool v);
+bool is_enabled();
+int64_t now();
+void record(phase_id phase, int64_t start, int64_t end);
+// forgets all recorded samples (but not the registered phases)
+void clear();
+
+// samples of all threads that are still in the ring buffers
+std::vector<sample> collect(std::vector<uint32_t>* thread_of_sample = nullptr);
+// the trace in the Chrome / Perfetto json trace event format
+std::string chrome_trace_json();
+std::vector<phase_summary> summarize();
+std::vector<phase_summary> summarize(std::vector<sample> const& samples);
+// a human readable table of the summary, sorted by total time
+std::string summary_text();
+
+// times the enclosing block as one sample of the phase
+class scope {
+	int64_t start = 0;
+	phase_id phase = 0;
+	bool active = false;
+
+public:
+	scope(phase_id p) noexcept : phase(p), active(is_enabled()) {
+		if(active)
+			start = now();
+	}
+	scope(scope const&) = delete;
+	scope& operator=(scope const&) = delete;
+	~scope() {
+		end();
+	}
+	// stops timing before the end of the enclosing block
+	void end() {
+		if(active)
+			record(phase, start, now());
+		active = false;
+	}
+};
+
+} // namespace profiler
@@ -0,0 +1,74 @@
+#include "ui_snapshot.hpp"
+#include "system_state.hpp"
+#include "demographics.hpp"
+
+namespace ui_snapshot {
+
+void set_enabled(sys::state& state, bool enabled) {
+	if(enabled)
+		state.ui_snapshot_buffers.generation.fetch_add(1, std::memory_order::acq_rel);
+	state.ui_snapshot_enabled.store(enabled, std::memory_order::release);
+}
+
+void take(sys::state& state) {
+	if(!state.ui_snapshot_enabled.load(std::memory_order::acquire))
+		return;
+
+	auto& d = state.ui_snapshot_buffers.write_buffer();
+	d.generation = state.ui_snapshot_buffers.generation.load(std::memory_order::acquire);
+	d.province_count = state.world.province_size();
+	d.nation_count = state.world.nation_size();
+	d.province_owner.resize(d.province_count);
+	d.province_controller.resize(d.province_count);
+	d.province_demographics.resize(size_t(d.province_count) * demographics::count_special_keys);
+	d.nation_demographics.resize(size_t(d.nation_count) * demographics::count_special_keys);
+
+	for(uint32_t i = 0; i < d.province_count; ++i) {
+		dcon::province_id p{ dcon::province_id::value_base_t(i) };
+		d.province_owner[i] = state.world.province_get_nation_from_province_ownership(p);
+		d.province_controller[i] = state.world.province_get_nation_from_province_control(p);
+		for(uint32_t k = 0; k < demographics::count_special_keys; ++k)
+			d.province_demographics[size_t(i) * demographics::count_special_keys + k] = state.world.province_get_demographics(p, dcon::demographics_key{ dcon::demographics_key::value_base_t(k) });
+	}
+	for(uint32_t i = 0; i < d.nation_count; ++i) {
+		dcon::nation_id n{ dcon::nation_id::value_base_t(i) };
+		for(uint32_t k = 0; k < demographics::count_special_keys; ++k)
+			d.nation_demographics[size_t(i) * demographics::count_special_keys + k] = state.world.nation_get_demographics(n, dcon::demographics_key{ dcon::demographics_key::value_base_t(k) });
+	}
+
+	state.ui_snapshot_buffers.publish();
+}
+
+view::view(sys::state& state) : state(state) {
+	if(state.ui_snapshot_enabled.load(std::memory_order::acquire)) {
+		auto& d = state.ui_snapshot_buffers.latest();
+		if(d.generation == state.ui_snapshot_buffers.generation.load(std::memory_order::acquire))
+			snapshot = &d;
+	}
+}
+
+dcon::nation_id view::province_owner(dcon::province_id p) const {
+	if(snapshot && uint32_t(p.index()) < snapshot->province_count)
+		return snapshot->province_owner[p.index()];
+	return state.world.province_get_nation_from_province_ownership(p);
+}
+
+dcon::nation_id view::province_controller(dcon::province_id p) const {
+	if(snapshot && uint32_t(p.index()) < snapshot->province_count)
+		return snapshot->province_controller[p.index()];
+	return state.world.province_get_nation_from_province_control(p);
+}
+
+float view::province_demographics(dcon::province_id p, dcon::demographics_key k) const {
+	if(snapshot && uint32_t(p.index()) < snapshot->province_count && uint32_t(k.index()) < demographics::count_special_keys)
+		return snapshot->province_demographics[size_t(p.index()) * demographics::count_special_keys + k.index()];
+	return state.world.province_get_demographics(p, k);
+}
+
+float view::nation_demographics(dcon::nation_id n, dcon::demographics_key k) const {
+	if(snapshot && uint32_t(n.index()) < snapshot->nation_count && uint32_t(k.index()) < demographics::count_special_keys)
+		return snapshot->nation_demographics[size_t(n.index()) * demographics::count_special_keys + k.index()];
+	return state.world.nation_get_demographics(n, k);
+}
+
+} // namespace ui_snapshot
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+#include "dcon_generated.hpp"
+
+// A copy of the game state values that the ui reads the most (the map modes, mostly), taken by the game thread after
+// each tick and after each batch of commands. There are three buffers: the game thread fills one, the ui reads another,
+// and the third holds the newest finished copy. Each side hands its buffer over with a single atomic exchange, so the
+// ui never waits for a tick to finish and never sees a copy that is only half written.
+
+namespace sys {
+struct state;
+}
+
+namespace ui_snapshot {
+
+struct data {
+	uint32_t generation = 0;
+	uint32_t province_count = 0;
+	uint32_t nation_count = 0;
+	std::vector<dcon::nation_id> province_owner;
+	std::vector<dcon::nation_id> province_controller;
+	std::vector<float> province_demographics; // the special demographics keys only, demographics::count_special_keys per province
+	std::vector<float> nation_demographics;   // likewise, per nation
+};
+
+class triple_buffer {
+	static constexpr uint8_t index_mask = 3;
+	static constexpr uint8_t fresh_bit = 4;
+
+	data buffers[3];
+	std::atomic<uint8_t> middle = 1;
+	uint8_t back = 2;  // only touched by the game thread
+	uint8_t front = 0; // only touched by the ui thread
+
+public:
+	// bumped every time snapshots are turned on, so that a copy left over from before is never read
+	std::atomic<uint32_t> generation = 1;
+
+	data& write_buffer() {
+		return buffers[back];
+	}
+	void publish() {
+		back = uint8_t(middle.exchange(uint8_t(back | fresh_bit), std::memory_order::acq_rel) & index_mask);
+	}
+	// the newest published copy; it stays valid until the next call
+	data const& latest() {
+		if((middle.load(std::memory_order::acquire) & fresh_bit) != 0)
+			front = uint8_t(middle.exchange(front, std::memory_order::acq_rel) & index_mask);
+		return buffers[front];
+	}
+};
+
+// ui thread: turns the snapshots on or off
+void set_enabled(sys::state& state, bool enabled);
+// game thread: copies the values into the write buffer and publishes it, if the ui has asked for snapshots
+void take(sys::state& state);
+
+// ui thread: reads from the newest snapshot when snapshots are enabled and from the live game state otherwise
+// (including for anything the snapshot does not cover). Make one per use, so that everything read comes from the same copy.
+class view {
+	sys::state& state;
+	data const* snapshot = nullptr;
+
+public:
+	view(sys::state& state);
+
+	dcon::nation_id province_owner(dcon::province_id p) const;
+	dcon::nation_id province_controller(dcon::province_id p) const;
+	float province_demographics(dcon::province_id p, dcon::demographics_key k) const;
+	float nation_demographics(dcon::nation_id n, dcon::demographics_key k) const;
+};
+
+} // namespace ui_snapshot
@@ -7,6 +7,7 @@
 #include "nations.hpp"
 #include "fif_dcon_generated.hpp"
 #include "fif_common.hpp"
+#include "tick_profiler.hpp"
 
 #define STB_IMAGE_WRITE_IMPLEMENTATION 1
 #include "stb_image_write.h"
@@ -1071,23 +1072,93 @@ int32_t* f_dump_econ(fif::state_stack& s, int32_t* p, fif::environment* e) {
 	auto state_global = fif::get_global_var(*e, "state-ptr");
 	sys::state* state = (sys::state*)(state_global->data);
 
+	uint32_t dropped_days = 0;
 	if(state->cheat_data.ecodump) {
 		state->cheat_data.ecodump = false;
-	} else {
+		dropped_days = economy_telemetry::stop(*state, true);
+	} else if(economy_telemetry::start(*state)) {
 		state->cheat_data.ecodump = true;
+	} else {
+		log_to_console(*state, state->ui_state.console_window, "The previous dump is still being written, try again later");
+	}
+	log_to_console(*state, state->ui_state.console_window, state->cheat_data.ecodump ? "✔" : "✘");
+	if(dropped_days != 0)
+		log_to_console(*state, state->ui_state.console_window, std::to_string(dropped_days) + " days were dropped from the dump because the writer fell behind");
 
-		state->world.for_each_commodity([&](dcon::commodity_id c) {
-			state->cheat_data.prices_dump_buffer += text::produce_simple_string(*state, state->world.commodity_get_name(c)) + ",";
-			state->cheat_data.demand_dump_buffer += text::produce_simple_string(*state, state->world.commodity_get_name(c)) + ",";
-			state->cheat_data.supply_dump_buffer += text::produce_simple_string(*state, state->world.commodity_get_name(c)) + ",";
-		});
+	return p + 2;
+}
+int32_t* f_turbo(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
 
-		state->cheat_data.prices_dump_buffer += "\n";
-		state->cheat_data.demand_dump_buffer += "\n";
-		state->cheat_data.supply_dump_buffer += "\n";
+	bool toggle_state = s.main_data_back(0) != 0;
+	s.pop_main();
+
+	state->turbo_fast_forward.store(toggle_state, std::memory_order::release);
+	log_to_console(*state, state->ui_state.console_window, toggle_state ? "✔" : "✘");
+	return p + 2;
+}
+int32_t* f_ui_snapshot(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
 	}
-	log_to_console(*state, state->ui_state.console_window, state->cheat_data.ecodump ? "✔" : "✘");
 
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	bool toggle_state = s.main_data_back(0) != 0;
+	s.pop_main();
+
+	ui_snapshot::set_enabled(*state, toggle_state);
+	log_to_console(*state, state->ui_state.console_window, toggle_state ? "✔" : "✘");
+	return p + 2;
+}
+int32_t* f_profile_ticks(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		s.pop_main();
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	bool toggle_state = s.main_data_back(0) != 0;
+	s.pop_main();
+
+	if(toggle_state && !profiler::is_enabled())
+		profiler::clear();
+	profiler::set_enabled(toggle_state);
+	log_to_console(*state, state->ui_state.console_window, toggle_state ? "✔" : "✘");
+	return p + 2;
+}
+int32_t* f_dump_profile(fif::state_stack& s, int32_t* p, fif::environment* e) {
+	if(fif::typechecking_mode(e->mode)) {
+		if(fif::typechecking_failed(e->mode))
+			return p + 2;
+		return p + 2;
+	}
+
+	auto state_global = fif::get_global_var(*e, "state-ptr");
+	sys::state* state = (sys::state*)(state_global->data);
+
+	auto dumps = simple_fs::get_or_create_data_dumps_directory();
+	auto trace = profiler::chrome_trace_json();
+	simple_fs::write_file(dumps, NATIVE("tick_profile.json"), trace.data(), uint32_t(trace.length()));
+	auto summary = profiler::summary_text();
+	simple_fs::write_file(dumps, NATIVE("tick_profile.txt"), summary.data(), uint32_t(summary.length()));
+	log_to_console(*state, state->ui_state.console_window, "Wrote tick_profile.json and tick_profile.txt to " + simple_fs::native_to_utf8(simple_fs::get_full_name(dumps)));
 	return p + 2;
 }
 int32_t* f_provid(fif::state_stack& s, int32_t* p, fif::environment* e) {
@@ -1408,6 +1479,10 @@ void ui::initialize_console_fif_environment(sys::state& state) {
 	fif::add_import("add-days", nullptr, f_add_days, { fif::fif_i32 }, {}, * state.fif_environment);
 	fif::add_import("save-map", nullptr, f_save_map, { fif::fif_i32 }, {}, * state.fif_environment);
 	fif::add_import("dump-econ", nullptr, f_dump_econ, {  }, {}, * state.fif_environment);
+	fif::add_import("turbo", nullptr, f_turbo, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("ui-snapshot", nullptr, f_ui_snapshot, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("profile-ticks", nullptr, f_profile_ticks, { fif::fif_bool }, {}, * state.fif_environment);
+	fif::add_import("dump-profile", nullptr, f_dump_profile, {  }, {}, * state.fif_environment);
 	fif::add_import("provid", nullptr, f_provid, { fif::fif_bool }, {}, * state.fif_environment);
 	fif::add_import("fire-event", nullptr, f_fire_event, { nation_id_type, fif::fif_i32 }, {}, * state.fif_environment);
 	fif::add_import("nation-name", nullptr, f_nation_name, { nation_id_type }, { state.type_text_key }, *state.fif_environment);
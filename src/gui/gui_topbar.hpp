@@ -450,9 +450,9 @@ public:
 
 				if(overlord == state.local_player_nation) {
 					float est_private_const_spending = economy::estimate_private_construction_spendings(state, n);
-					auto craved_constructions = economy::estimate_private_investment_construct(state, n, true, est_private_const_spending);
+					auto craved_constructions = economy::estimate_private_investment_construct(state, n, true, est_private_const_spending, false);
 					auto upgrades = economy::estimate_private_investment_upgrade(state, n, est_private_const_spending);
-					auto constructions = economy::estimate_private_investment_construct(state, n, false, est_private_const_spending);
+					auto constructions = economy::estimate_private_investment_construct(state, n, false, est_private_const_spending, false);
 					auto province_constr = economy::estimate_private_investment_province(state, n, est_private_const_spending);
 
 					if(economy::estimate_private_construction_spendings(state, n) < 1.0f && upgrades.size() == 0 && constructions.size() == 0 && province_constr.size() == 0) {
@@ -488,9 +488,9 @@ public:
 		}
 		{
 			float est_private_const_spending = economy::estimate_private_construction_spendings(state, state.local_player_nation);
-			auto craved_constructions = economy::estimate_private_investment_construct(state, state.local_player_nation, true, est_private_const_spending);
+			auto craved_constructions = economy::estimate_private_investment_construct(state, state.local_player_nation, true, est_private_const_spending, false);
 			auto upgrades = economy::estimate_private_investment_upgrade(state, state.local_player_nation, est_private_const_spending);
-			auto constructions = economy::estimate_private_investment_construct(state, state.local_player_nation, false, est_private_const_spending);
+			auto constructions = economy::estimate_private_investment_construct(state, state.local_player_nation, false, est_private_const_spending, false);
 			auto province_constr = economy::estimate_private_investment_province(state, state.local_player_nation, est_private_const_spending);
 
 			if(private_constr < 1.f && upgrades.size() == 0 && constructions.size() == 0 && province_constr.size() == 0) {
@@ -267,7 +267,7 @@ public:
 		desired_types.clear();
 		auto sid = retrieve<dcon::state_instance_id>(state, parent);
 		auto m = state.world.state_instance_get_market_from_local_market(sid);
-		ai::get_desired_factory_types(state, state.local_player_nation, m, desired_types);
+		ai::get_desired_factory_types(state, state.local_player_nation, m, desired_types, false);
 	}
 
 	message_result get(sys::state& state, Cyto::Any& payload) noexcept override {
@@ -302,7 +302,7 @@ public:
 		row_contents.clear();
 		desired_types.clear();
 		auto m = state.world.state_instance_get_market_from_local_market(sid);
-		ai::get_desired_factory_types(state, state.local_player_nation, m, desired_types);
+		ai::get_desired_factory_types(state, state.local_player_nation, m, desired_types, false);
 
 		// First the desired factory types
 		for(const auto ftid : desired_types)
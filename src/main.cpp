@@ -23,6 +23,8 @@
 #include "economy_stats.cpp"
 #include "economy.cpp"
 #include "economy_government.cpp"
+#include "economy_history.cpp"
+#include "economy_telemetry.cpp"
 #include "construction.cpp"
 #include "demographics.cpp"
 #include "bmfont.cpp"
@@ -50,6 +52,9 @@
 #include "network.cpp"
 #include "diplomatic_messages.cpp"
 #include "notifications.cpp"
+#include "tick_graph.cpp"
+#include "tick_profiler.cpp"
+#include "ui_snapshot.cpp"
 #include "map_tooltip.cpp"
 #include "unit_tooltip.cpp"
 #include "ai.cpp"
@@ -247,12 +247,13 @@ std::vector<uint32_t> con_map_from(sys::state& state) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
+	ui_snapshot::view values{ state };
+	auto sel_nation = values.province_owner(state.map_state.get_selected_province());
 	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
+		auto nation = values.province_owner(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
 			auto scale = 1.f / 10.f;
-			auto value = scale * (state.world.province_get_demographics(prov_id, demographics::consciousness) / state.world.province_get_demographics(prov_id, demographics::total));
+			auto value = scale * (values.province_demographics(prov_id, demographics::consciousness) / values.province_demographics(prov_id, demographics::total));
 			uint32_t color = ogl::color_gradient_magma(value);
 			auto i = province::to_map_id(prov_id);
 			prov_color[i] = color;
@@ -266,11 +267,12 @@ std::vector<uint32_t> literacy_map_from(sys::state& state) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
+	ui_snapshot::view values{ state };
+	auto sel_nation = values.province_owner(state.map_state.get_selected_province());
 	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
+		auto nation = values.province_owner(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
-			auto value = (state.world.province_get_demographics(prov_id, demographics::literacy) / state.world.province_get_demographics(prov_id, demographics::total));
+			auto value = (values.province_demographics(prov_id, demographics::literacy) / values.province_demographics(prov_id, demographics::total));
 			uint32_t color = ogl::color_gradient_viridis(value);
 			auto i = province::to_map_id(prov_id);
 			prov_color[i] = color;
@@ -363,11 +365,12 @@ std::vector<uint32_t> employment_map_from(sys::state& state) {
 	uint32_t province_size = state.world.province_size();
 	uint32_t texture_size = province_size + 256 - province_size % 256;
 	std::vector<uint32_t> prov_color(texture_size * 2);
-	auto sel_nation = state.world.province_get_nation_from_province_ownership(state.map_state.get_selected_province());
+	ui_snapshot::view values{ state };
+	auto sel_nation = values.province_owner(state.map_state.get_selected_province());
 	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto nation = state.world.province_get_nation_from_province_ownership(prov_id);
+		auto nation = values.province_owner(prov_id);
 		if((sel_nation && nation == sel_nation) || !sel_nation) {
-			auto value = state.world.province_get_demographics(prov_id, demographics::employed) / state.world.province_get_demographics(prov_id, demographics::employable);
+			auto value = values.province_demographics(prov_id, demographics::employed) / values.province_demographics(prov_id, demographics::employable);
 			uint32_t color = ogl::color_gradient(value,
 				sys::pack_color(46, 247, 15), // green
 				sys::pack_color(247, 15, 15) // red
@@ -1,12 +1,13 @@
 #pragma once
 
 std::vector<uint32_t> get_global_population_color(sys::state& state) {
+	ui_snapshot::view values{ state };
 	std::vector<float> prov_population(state.world.province_size() + 1);
 	std::unordered_map<int32_t, float> continent_max_pop = {};
 
 	state.world.for_each_province([&](dcon::province_id prov_id) {
 		auto fat_id = dcon::fatten(state.world, prov_id);
-		float population = state.world.province_get_demographics(prov_id, demographics::total);
+		float population = values.province_demographics(prov_id, demographics::total);
 		auto cid = fat_id.get_continent().id.index();
 		continent_max_pop[cid] = std::max(continent_max_pop[cid], population);
 		auto i = province::to_map_id(prov_id);
@@ -38,14 +39,14 @@ std::vector<uint32_t> get_national_population_color(sys::state& state) {
 	if(!bool(nat_id)) {
 		return get_global_population_color(state);
 	}
+	ui_snapshot::view values{ state };
 	float max_population = 0.f;
 	std::vector<float> prov_population(state.world.province_size() + 1);
 
 	state.world.for_each_province([&](dcon::province_id prov_id) {
-		auto fat_id = dcon::fatten(state.world, prov_id);
 		auto i = province::to_map_id(prov_id);
-		if(fat_id.get_nation_from_province_ownership().id == nat_id.id) {
-			float population = state.world.province_get_demographics(prov_id, demographics::total);
+		if(values.province_owner(prov_id) == nat_id.id) {
+			float population = values.province_demographics(prov_id, demographics::total);
 			max_population = std::max(max_population, population);
 			prov_population[i] = population;
 		} else {
@@ -13,6 +13,7 @@
 #include "simple_fs.hpp"
 #include "network.hpp"
 #include "demographics.hpp"
+#include "tick_profiler.hpp"
 
 #include <text.hpp>
 #include "json.hpp"
@@ -102,6 +103,10 @@ inline void init(sys::state& state) noexcept {
 		for(auto cid : state.world.in_commodity) {
 			state.world.for_each_trade_route([&](dcon::trade_route_id trade_route) {
 				auto current_volume = state.world.trade_route_get_volume(trade_route, cid);
+				// most routes carry nothing of a given commodity
+				if(current_volume == 0.f) {
+					return;
+				}
 				auto origin =
 					current_volume > 0.f
 					? state.world.trade_route_get_connected_markets(trade_route, 0)
@@ -304,6 +309,64 @@ inline void init(sys::state& state) noexcept {
 		res.set_content(j.dump(), "text/plain");
 	});
 
+	// economic history: /history/<series>/<id>, where the series is price, gdp, treasury, population or trade_volume and
+	// the id is a nation, or a commodity for trade_volume; prices also take ?commodity=<id> with the state definition as id.
+	// ?from= and ?to= limit the range, in days since the start of the game
+	svr.Get(R"(/history/(\w+)/(\d+))", [&](const httplib::Request& req, httplib::Response& res) {
+		auto name = req.matches[1].str();
+		auto id = uint32_t(std::atoi(req.matches[2].str().c_str()));
+
+		static constexpr std::array<std::string_view, size_t(economy_history::series::count)> names = { "price", "gdp", "treasury", "population", "trade_volume" };
+		auto found = std::find(names.begin(), names.end(), name);
+		if(found == names.end()) {
+			res.status = 404;
+			return;
+		}
+		auto s = economy_history::series(found - names.begin());
+		auto column = id;
+		if(s == economy_history::series::price) {
+			dcon::commodity_id c{ dcon::commodity_id::value_base_t(req.has_param("commodity") ? std::atoi(req.get_param_value("commodity").c_str()) : 0) };
+			column = economy_history::price_column(state, dcon::state_definition_id{ dcon::state_definition_id::value_base_t(id) }, c);
+		}
+		sys::date from{ 0 };
+		sys::date to{ uint16_t(std::numeric_limits<uint16_t>::max() - 1) };
+		if(req.has_param("from"))
+			from = sys::date{ uint16_t(std::atoi(req.get_param_value("from").c_str())) };
+		if(req.has_param("to"))
+			to = sys::date{ uint16_t(std::atoi(req.get_param_value("to").c_str())) };
+
+		json jlist = json::array();
+		for(auto& v : economy_history::query(state, s, column, from, to)) {
+			auto dt = v.date.to_ymd(state.start_date);
+			json j = json::object();
+			j["date"] = std::to_string(dt.day) + "." + std::to_string(dt.month) + "." + std::to_string(dt.year);
+			j["value"] = v.value;
+			jlist.push_back(j);
+		}
+		res.set_content(jlist.dump(), "text/plain");
+	});
+
+	// tick profiler: enable with the profile-ticks console command
+	svr.Get("/profile", [&](const httplib::Request& req, httplib::Response& res) {
+		res.set_content(profiler::chrome_trace_json(), "application/json");
+	});
+
+	svr.Get("/profile/summary", [&](const httplib::Request& req, httplib::Response& res) {
+		json jlist = json::array();
+		for(auto& ps : profiler::summarize()) {
+			json j = json::object();
+			j["phase"] = ps.name;
+			j["count"] = ps.count;
+			j["min_ms"] = ps.min_ms;
+			j["mean_ms"] = ps.mean_ms;
+			j["p99_ms"] = ps.p99_ms;
+			j["max_ms"] = ps.max_ms;
+			j["total_ms"] = ps.total_ms;
+			jlist.push_back(j);
+		}
+		res.set_content(jlist.dump(), "text/plain");
+	});
+
 	svr.listen("0.0.0.0", 1234);
 }
 
@@ -662,6 +662,9 @@
 	LUA_DEFINES_LIST_ELEMENT(alice_speed_2, 750.000000)                                                                            \
 	LUA_DEFINES_LIST_ELEMENT(alice_speed_3, 250.000000)                                                                            \
 	LUA_DEFINES_LIST_ELEMENT(alice_speed_4, 125.000000)                                                                            \
+	LUA_DEFINES_LIST_ELEMENT(alice_turbo_ticks_per_batch, 10.000000)                                                               \
+	LUA_DEFINES_LIST_ELEMENT(alice_turbo_days_per_ui_update, 30.000000)                                                            \
+	LUA_DEFINES_LIST_ELEMENT(alice_turbo_ms_per_ui_update, 500.000000)                                                             \
 	LUA_DEFINES_LIST_ELEMENT(alice_ai_gather_radius, -0.996000)                                                                    \
 	LUA_DEFINES_LIST_ELEMENT(alice_ai_threat_radius, -0.996000)                                                                    \
 	LUA_DEFINES_LIST_ELEMENT(alice_ai_threat_overestimate, 1.150000)                                                               \
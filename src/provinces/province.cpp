@@ -206,6 +206,67 @@ void set_province_controller(sys::state& state, dcon::province_id p, dcon::rebel
 	}
 }
 
+void update_is_owner_core(sys::state& state, dcon::province_id pid) {
+	auto owner = state.world.province_get_nation_from_province_ownership(pid);
+	if(owner) {
+		bool owner_core = false;
+		for(auto c : state.world.province_get_core(pid)) {
+			if(c.get_identity().get_nation_from_identity_holder() == owner) {
+				owner_core = true;
+				break;
+			}
+		}
+		state.world.province_set_is_owner_core(pid, owner_core);
+	} else {
+		state.world.province_set_is_owner_core(pid, false);
+	}
+}
+
+void add_to_cached_values(sys::state& state, dcon::province_id pid, dcon::nation_id owner) {
+	bool reb_controlled = bool(state.world.province_get_rebel_faction_from_province_rebel_control(pid));
+
+	if(reb_controlled) {
+		state.world.nation_get_rebel_controlled_count(owner) += uint16_t(1);
+	}
+	if(state.world.province_get_is_coast(pid)) {
+		state.world.nation_get_total_ports(owner) += uint16_t(1);
+	}
+	if(auto c = state.world.province_get_nation_from_province_control(pid); bool(c) && c != owner) {
+		state.world.nation_get_occupied_count(owner) += uint16_t(1);
+	}
+	if(state.world.province_get_is_colonial(pid)) {
+		state.world.nation_set_is_colonial_nation(owner, true);
+	}
+	if(!is_overseas(state, pid)) {
+		state.world.nation_get_central_province_count(owner) += uint16_t(1);
+
+		if(military::province_is_blockaded(state, pid)) {
+			state.world.nation_get_central_blockaded(owner) += uint16_t(1);
+		}
+		if(state.world.province_get_is_coast(pid)) {
+			state.world.nation_get_central_ports(owner) += uint16_t(1);
+		}
+		if(reb_controlled) {
+			state.world.nation_get_central_rebel_controlled(owner) += uint16_t(1);
+		}
+		if(state.world.province_get_crime(pid)) {
+			state.world.nation_get_central_crime_count(owner) += uint16_t(1);
+		}
+	}
+}
+
+void update_state_capital(sys::state& state, dcon::state_instance_id s) {
+	auto owner = state.world.state_instance_get_nation_from_state_ownership(s);
+	dcon::province_id p;
+	for(auto prv : state.world.state_definition_get_abstract_state_membership(state.world.state_instance_get_definition(s))) {
+		if(state.world.province_get_nation_from_province_ownership(prv.get_province()) == owner) {
+			p = prv.get_province().id;
+			break;
+		}
+	}
+	state.world.state_instance_set_capital(s, p);
+}
+
 void restore_cached_values(sys::state& state) {
 	
 	state.world.execute_serial_over_nation([&](auto ids) { state.world.nation_set_central_province_count(ids, ve::int_vector()); });
@@ -229,20 +290,7 @@ void restore_cached_values(sys::state& state) {
 
 	for(int32_t i = 0; i < state.province_definitions.first_sea_province.index(); ++i) {
 		dcon::province_id pid{dcon::province_id::value_base_t(i)};
-
-		auto owner = state.world.province_get_nation_from_province_ownership(pid);
-		if(owner) {
-			bool owner_core = false;
-			for(auto c : state.world.province_get_core(pid)) {
-				if(c.get_identity().get_nation_from_identity_holder() == owner) {
-					owner_core = true;
-					break;
-				}
-			}
-			state.world.province_set_is_owner_core(pid, owner_core);
-		} else {
-			state.world.province_set_is_owner_core(pid, false);
-		}
+		update_is_owner_core(state, pid);
 	}
 
 	for(auto n : state.world.in_nation) {
@@ -256,60 +304,64 @@ void restore_cached_values(sys::state& state) {
 
 		auto owner = state.world.province_get_nation_from_province_ownership(pid);
 		if(owner) {
-
-			bool reb_controlled = bool(state.world.province_get_rebel_faction_from_province_rebel_control(pid));
-
-			if(reb_controlled) {
-				state.world.nation_get_rebel_controlled_count(owner) += uint16_t(1);
-			}
-			if(state.world.province_get_is_coast(pid)) {
-				state.world.nation_get_total_ports(owner) += uint16_t(1);
-			}
-			if(auto c = state.world.province_get_nation_from_province_control(pid); bool(c) && c != owner) {
-				state.world.nation_get_occupied_count(owner) += uint16_t(1);
-			}
-			if(state.world.province_get_is_colonial(pid)) {
-				state.world.nation_set_is_colonial_nation(owner, true);
-			}
-			if(!is_overseas(state, pid)) {
-				state.world.nation_get_central_province_count(owner) += uint16_t(1);
-
-				if(military::province_is_blockaded(state, pid)) {
-					state.world.nation_get_central_blockaded(owner) += uint16_t(1);
-				}
-				if(state.world.province_get_is_coast(pid)) {
-					state.world.nation_get_central_ports(owner) += uint16_t(1);
-				}
-				if(reb_controlled) {
-					state.world.nation_get_central_rebel_controlled(owner) += uint16_t(1);
-				}
-				if(state.world.province_get_crime(pid)) {
-					state.world.nation_get_central_crime_count(owner) += uint16_t(1);
-				}
-			}
+			add_to_cached_values(state, pid, owner);
 		}
 	}
 	state.world.for_each_state_instance([&](dcon::state_instance_id s) {
 		auto owner = state.world.state_instance_get_nation_from_state_ownership(s);
 		state.world.nation_get_owned_state_count(owner) += uint16_t(1);
-		dcon::province_id p;
-		for(auto prv : state.world.state_definition_get_abstract_state_membership(state.world.state_instance_get_definition(s))) {
-			if(state.world.province_get_nation_from_province_ownership(prv.get_province()) == owner) {
-				p = prv.get_province().id;
-				break;
-			}
-		}
-		state.world.state_instance_set_capital(s, p);
+		update_state_capital(state, s);
 	});
 }
 
-void update_cached_values(sys::state& state) {
-	if(!state.national_cached_values_out_of_date)
-		return;
+void restore_cached_values(sys::state& state, dcon::nation_id n) {
+	state.world.nation_set_central_province_count(n, 0);
+	state.world.nation_set_central_blockaded(n, 0);
+	state.world.nation_set_central_rebel_controlled(n, 0);
+	state.world.nation_set_rebel_controlled_count(n, 0);
+	state.world.nation_set_central_ports(n, 0);
+	state.world.nation_set_central_crime_count(n, 0);
+	state.world.nation_set_total_ports(n, 0);
+	state.world.nation_set_occupied_count(n, 0);
+	state.world.nation_set_owned_state_count(n, 0);
+	state.world.nation_set_is_colonial_nation(n, false);
 
-	state.national_cached_values_out_of_date = false;
+	auto orange = state.world.nation_get_province_ownership(n);
+	state.world.nation_set_owned_province_count(n, uint16_t(orange.end() - orange.begin()));
 
-	restore_cached_values(state);
+	for(auto p : orange) {
+		update_is_owner_core(state, p.get_province().id);
+	}
+	if(state.world.province_get_nation_from_province_ownership(state.world.nation_get_capital(n)) != n) {
+		state.world.nation_set_capital(n, pick_capital(state, n));
+	}
+	for(auto p : orange) {
+		add_to_cached_values(state, p.get_province().id, n);
+	}
+	for(auto s : state.world.nation_get_state_ownership(n)) {
+		state.world.nation_get_owned_state_count(n) += uint16_t(1);
+		update_state_capital(state, s.get_state().id);
+	}
+}
+
+void update_cached_values(sys::state& state) {
+	if(state.national_cached_values_out_of_date) {
+		state.national_cached_values_out_of_date = false;
+		restore_cached_values(state);
+	} else {
+		// every count above only depends on the provinces that the nation owns, so only the nations that gained or
+		// lost a province need to be looked at
+		for(auto p : state.provinces_with_changed_owner) {
+			if(!state.world.province_get_nation_from_province_ownership(p))
+				state.world.province_set_is_owner_core(p, false);
+		}
+		for(auto n : state.nations_with_changed_provinces) {
+			if(state.world.nation_is_valid(n))
+				restore_cached_values(state, n);
+		}
+	}
+	state.provinces_with_changed_owner.clear();
+	state.nations_with_changed_provinces.clear();
 }
 
 void update_blockaded_cache(sys::state& state) {
@@ -724,7 +776,9 @@ void change_province_owner(sys::state& state, dcon::province_id id, dcon::nation
 		return;
 
 	state.adjacency_data_out_of_date = true;
-	state.national_cached_values_out_of_date = true;
+	state.nations_with_changed_provinces.mark(old_owner);
+	state.nations_with_changed_provinces.mark(new_owner);
+	state.provinces_with_changed_owner.mark(id);
 
 	bool state_is_new = false;
 	dcon::state_instance_id new_si;
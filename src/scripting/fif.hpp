@@ -11,7 +11,7 @@
 #include <span>
 #include <limits>
 
-#ifdef _WIN64
+#if defined(_WIN64) || defined(ALICE_LLVM_AVAILABLE)
 #define USE_LLVM
 #else
 #endif
@@ -5935,4 +5935,334 @@ ve::mask_vector evaluate(sys::state& state, uint16_t const* data, ve::contiguous
 	return test_trigger_generic<ve::mask_vector>(data, state, primary, this_slot, from_slot);
 }
 
+// the codes whose function reads the this or from slot (a stored trigger could read anything); a new trigger that looks at
+// either slot has to be listed here. Scopes only pass both slots along to their contents, except for the ones that switch
+// to them
+static bool code_reads_this_or_from(uint16_t code) {
+	switch(code) {
+	case trigger::culture_pop_reb:
+	case trigger::culture_state_reb:
+	case trigger::culture_province_reb:
+	case trigger::culture_nation_reb:
+	case trigger::culture_from_nation:
+	case trigger::culture_this_nation:
+	case trigger::culture_this_state:
+	case trigger::culture_this_pop:
+	case trigger::culture_this_province:
+	case trigger::culture_group_reb_nation:
+	case trigger::culture_group_reb_pop:
+	case trigger::culture_group_nation_from_nation:
+	case trigger::culture_group_pop_from_nation:
+	case trigger::culture_group_nation_this_nation:
+	case trigger::culture_group_pop_this_nation:
+	case trigger::culture_group_nation_this_province:
+	case trigger::culture_group_pop_this_province:
+	case trigger::culture_group_nation_this_state:
+	case trigger::culture_group_pop_this_state:
+	case trigger::culture_group_nation_this_pop:
+	case trigger::culture_group_pop_this_pop:
+	case trigger::religion_reb:
+	case trigger::religion_from_nation:
+	case trigger::religion_this_nation:
+	case trigger::religion_this_state:
+	case trigger::religion_this_province:
+	case trigger::religion_this_pop:
+	case trigger::is_cultural_union_this_self_pop:
+	case trigger::is_cultural_union_this_pop:
+	case trigger::is_cultural_union_this_state:
+	case trigger::is_cultural_union_this_province:
+	case trigger::is_cultural_union_this_nation:
+	case trigger::is_cultural_union_this_rebel:
+	case trigger::is_cultural_union_tag_this_pop:
+	case trigger::is_cultural_union_tag_this_state:
+	case trigger::is_cultural_union_tag_this_province:
+	case trigger::is_cultural_union_tag_this_nation:
+	case trigger::is_core_this_nation:
+	case trigger::is_core_this_state:
+	case trigger::is_core_this_province:
+	case trigger::is_core_this_pop:
+	case trigger::is_core_from_nation:
+	case trigger::is_core_reb:
+	case trigger::num_of_cities_from_nation:
+	case trigger::num_of_cities_this_nation:
+	case trigger::num_of_cities_this_state:
+	case trigger::num_of_cities_this_province:
+	case trigger::num_of_cities_this_pop:
+	case trigger::owned_by_from_nation:
+	case trigger::owned_by_this_nation:
+	case trigger::owned_by_this_province:
+	case trigger::owned_by_this_state:
+	case trigger::owned_by_this_pop:
+	case trigger::continent_nation_this:
+	case trigger::continent_state_this:
+	case trigger::continent_province_this:
+	case trigger::continent_pop_this:
+	case trigger::continent_nation_from:
+	case trigger::continent_state_from:
+	case trigger::continent_province_from:
+	case trigger::continent_pop_from:
+	case trigger::casus_belli_from:
+	case trigger::casus_belli_this_nation:
+	case trigger::casus_belli_this_state:
+	case trigger::casus_belli_this_province:
+	case trigger::casus_belli_this_pop:
+	case trigger::military_access_from:
+	case trigger::military_access_this_nation:
+	case trigger::military_access_this_state:
+	case trigger::military_access_this_province:
+	case trigger::military_access_this_pop:
+	case trigger::prestige_from:
+	case trigger::prestige_this_nation:
+	case trigger::prestige_this_state:
+	case trigger::prestige_this_province:
+	case trigger::prestige_this_pop:
+	case trigger::tag_this_nation:
+	case trigger::tag_this_province:
+	case trigger::tag_from_nation:
+	case trigger::tag_from_province:
+	case trigger::neighbour_this:
+	case trigger::neighbour_from:
+	case trigger::units_in_province_from:
+	case trigger::units_in_province_this_nation:
+	case trigger::units_in_province_this_province:
+	case trigger::units_in_province_this_state:
+	case trigger::units_in_province_this_pop:
+	case trigger::war_with_from:
+	case trigger::war_with_this_nation:
+	case trigger::war_with_this_province:
+	case trigger::war_with_this_state:
+	case trigger::war_with_this_pop:
+	case trigger::is_primary_culture_nation_this_pop:
+	case trigger::is_primary_culture_nation_this_nation:
+	case trigger::is_primary_culture_nation_this_state:
+	case trigger::is_primary_culture_nation_this_province:
+	case trigger::is_primary_culture_state_this_pop:
+	case trigger::is_primary_culture_state_this_nation:
+	case trigger::is_primary_culture_state_this_state:
+	case trigger::is_primary_culture_state_this_province:
+	case trigger::is_primary_culture_province_this_pop:
+	case trigger::is_primary_culture_province_this_nation:
+	case trigger::is_primary_culture_province_this_state:
+	case trigger::is_primary_culture_province_this_province:
+	case trigger::is_primary_culture_pop_this_pop:
+	case trigger::is_primary_culture_pop_this_nation:
+	case trigger::is_primary_culture_pop_this_state:
+	case trigger::is_primary_culture_pop_this_province:
+	case trigger::in_sphere_from:
+	case trigger::in_sphere_this_nation:
+	case trigger::in_sphere_this_province:
+	case trigger::in_sphere_this_state:
+	case trigger::in_sphere_this_pop:
+	case trigger::controlled_by_from:
+	case trigger::controlled_by_this_nation:
+	case trigger::controlled_by_this_province:
+	case trigger::controlled_by_this_state:
+	case trigger::controlled_by_this_pop:
+	case trigger::controlled_by_reb:
+	case trigger::truce_with_from:
+	case trigger::truce_with_this_nation:
+	case trigger::truce_with_this_province:
+	case trigger::truce_with_this_state:
+	case trigger::truce_with_this_pop:
+	case trigger::vassal_of_from:
+	case trigger::vassal_of_this_nation:
+	case trigger::vassal_of_this_province:
+	case trigger::vassal_of_this_state:
+	case trigger::vassal_of_this_pop:
+	case trigger::alliance_with_from:
+	case trigger::alliance_with_this_nation:
+	case trigger::alliance_with_this_province:
+	case trigger::alliance_with_this_state:
+	case trigger::alliance_with_this_pop:
+	case trigger::in_default_from:
+	case trigger::in_default_this_nation:
+	case trigger::in_default_this_province:
+	case trigger::in_default_this_state:
+	case trigger::in_default_this_pop:
+	case trigger::industrial_score_from_nation:
+	case trigger::industrial_score_this_nation:
+	case trigger::industrial_score_this_pop:
+	case trigger::industrial_score_this_state:
+	case trigger::industrial_score_this_province:
+	case trigger::military_score_from_nation:
+	case trigger::military_score_this_nation:
+	case trigger::military_score_this_pop:
+	case trigger::military_score_this_state:
+	case trigger::military_score_this_province:
+	case trigger::this_culture_union_from:
+	case trigger::this_culture_union_this_nation:
+	case trigger::this_culture_union_this_province:
+	case trigger::this_culture_union_this_state:
+	case trigger::this_culture_union_this_pop:
+	case trigger::this_culture_union_this_union_nation:
+	case trigger::this_culture_union_this_union_province:
+	case trigger::this_culture_union_this_union_state:
+	case trigger::this_culture_union_this_union_pop:
+	case trigger::brigades_compare_this:
+	case trigger::brigades_compare_from:
+	case trigger::constructing_cb_from:
+	case trigger::constructing_cb_this_nation:
+	case trigger::constructing_cb_this_province:
+	case trigger::constructing_cb_this_state:
+	case trigger::constructing_cb_this_pop:
+	case trigger::is_our_vassal_from:
+	case trigger::is_our_vassal_this_nation:
+	case trigger::is_our_vassal_this_province:
+	case trigger::is_our_vassal_this_state:
+	case trigger::is_our_vassal_this_pop:
+	case trigger::substate_of_from:
+	case trigger::substate_of_this_nation:
+	case trigger::substate_of_this_province:
+	case trigger::substate_of_this_state:
+	case trigger::substate_of_this_pop:
+	case trigger::is_sphere_leader_of_from:
+	case trigger::is_sphere_leader_of_this_nation:
+	case trigger::is_sphere_leader_of_this_province:
+	case trigger::is_sphere_leader_of_this_state:
+	case trigger::is_sphere_leader_of_this_pop:
+	case trigger::is_releasable_vassal_from:
+	case trigger::is_releasable_vassal_other:
+	case trigger::has_cultural_sphere:
+	case trigger::has_pop_culture_pop_this_pop:
+	case trigger::has_pop_culture_state_this_pop:
+	case trigger::has_pop_culture_province_this_pop:
+	case trigger::has_pop_culture_nation_this_pop:
+	case trigger::has_pop_religion_pop_this_pop:
+	case trigger::has_pop_religion_state_this_pop:
+	case trigger::has_pop_religion_province_this_pop:
+	case trigger::has_pop_religion_nation_this_pop:
+	case trigger::diplomatic_influence_this_nation:
+	case trigger::diplomatic_influence_this_province:
+	case trigger::diplomatic_influence_from_nation:
+	case trigger::diplomatic_influence_from_province:
+	case trigger::pop_unemployment_nation_this_pop:
+	case trigger::pop_unemployment_state_this_pop:
+	case trigger::pop_unemployment_province_this_pop:
+	case trigger::relation_this_nation:
+	case trigger::relation_this_province:
+	case trigger::relation_from_nation:
+	case trigger::relation_from_province:
+	case trigger::party_loyalty_nation_from_province:
+	case trigger::can_build_in_province_railroad_no_limit_from_nation:
+	case trigger::can_build_in_province_railroad_yes_limit_from_nation:
+	case trigger::can_build_in_province_railroad_no_limit_this_nation:
+	case trigger::can_build_in_province_railroad_yes_limit_this_nation:
+	case trigger::can_build_in_province_fort_no_limit_from_nation:
+	case trigger::can_build_in_province_fort_yes_limit_from_nation:
+	case trigger::can_build_in_province_fort_no_limit_this_nation:
+	case trigger::can_build_in_province_fort_yes_limit_this_nation:
+	case trigger::can_build_in_province_naval_base_no_limit_from_nation:
+	case trigger::can_build_in_province_naval_base_yes_limit_from_nation:
+	case trigger::can_build_in_province_naval_base_no_limit_this_nation:
+	case trigger::can_build_in_province_naval_base_yes_limit_this_nation:
+	case trigger::has_culture_core_province_this_pop:
+	case trigger::religion_nation_reb:
+	case trigger::religion_nation_from_nation:
+	case trigger::religion_nation_this_nation:
+	case trigger::religion_nation_this_state:
+	case trigger::religion_nation_this_province:
+	case trigger::religion_nation_this_pop:
+	case trigger::is_cultural_union_pop_this_pop:
+	case trigger::owned_by_state_from_nation:
+	case trigger::owned_by_state_this_nation:
+	case trigger::owned_by_state_this_province:
+	case trigger::owned_by_state_this_state:
+	case trigger::owned_by_state_this_pop:
+	case trigger::primary_culture_from_nation:
+	case trigger::primary_culture_from_province:
+	case trigger::neighbour_this_province:
+	case trigger::neighbour_from_province:
+	case trigger::brigades_compare_province_this:
+	case trigger::brigades_compare_province_from:
+	case trigger::is_accepted_culture_nation_this_pop:
+	case trigger::is_accepted_culture_nation_this_nation:
+	case trigger::is_accepted_culture_nation_this_state:
+	case trigger::is_accepted_culture_nation_this_province:
+	case trigger::is_accepted_culture_state_this_pop:
+	case trigger::is_accepted_culture_state_this_nation:
+	case trigger::is_accepted_culture_state_this_state:
+	case trigger::is_accepted_culture_state_this_province:
+	case trigger::is_accepted_culture_province_this_pop:
+	case trigger::is_accepted_culture_province_this_nation:
+	case trigger::is_accepted_culture_province_this_state:
+	case trigger::is_accepted_culture_province_this_province:
+	case trigger::is_accepted_culture_pop_this_pop:
+	case trigger::is_accepted_culture_pop_this_nation:
+	case trigger::is_accepted_culture_pop_this_state:
+	case trigger::is_accepted_culture_pop_this_province:
+	case trigger::have_core_in_nation_this:
+	case trigger::have_core_in_nation_from:
+	case trigger::country_units_in_state_from:
+	case trigger::country_units_in_state_this_nation:
+	case trigger::country_units_in_state_this_province:
+	case trigger::country_units_in_state_this_state:
+	case trigger::country_units_in_state_this_pop:
+	case trigger::stronger_army_than_this_nation:
+	case trigger::stronger_army_than_this_state:
+	case trigger::stronger_army_than_this_province:
+	case trigger::stronger_army_than_this_pop:
+	case trigger::stronger_army_than_from_nation:
+	case trigger::stronger_army_than_from_province:
+	case trigger::is_core_state_this_nation:
+	case trigger::is_core_state_this_province:
+	case trigger::is_core_state_this_pop:
+	case trigger::is_core_state_from_nation:
+	case trigger::is_our_vassal_province_from:
+	case trigger::is_our_vassal_province_this_nation:
+	case trigger::is_our_vassal_province_this_province:
+	case trigger::is_our_vassal_province_this_state:
+	case trigger::is_our_vassal_province_this_pop:
+	case trigger::vassal_of_province_from:
+	case trigger::vassal_of_province_this_nation:
+	case trigger::vassal_of_province_this_province:
+	case trigger::vassal_of_province_this_state:
+	case trigger::vassal_of_province_this_pop:
+	case trigger::relation_this_pop:
+	case trigger::pop_majority_religion_nation_this_nation:
+	case trigger::test:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool reads_this_or_from(uint16_t const* data) {
+	auto const code = uint16_t(data[0] & trigger::code_mask);
+	if(code >= trigger::first_scope_code) {
+		switch(code) {
+		case trigger::this_scope_nation:
+		case trigger::this_scope_state:
+		case trigger::this_scope_province:
+		case trigger::this_scope_pop:
+		case trigger::from_scope_nation:
+		case trigger::from_scope_state:
+		case trigger::from_scope_province:
+		case trigger::from_scope_pop:
+		case trigger::this_bounce_scope:
+		case trigger::from_bounce_scope:
+		case trigger::independence_scope:
+			return true;
+		default:
+			break;
+		}
+		auto const end = data + 1 + get_trigger_scope_payload_size(data);
+		for(auto sub = data + 2 + trigger_scope_data_payload(data[0]); sub < end; sub += 1 + get_trigger_payload_size(sub)) {
+			if(reads_this_or_from(sub))
+				return true;
+		}
+		return false;
+	}
+	return code_reads_this_or_from(code);
+}
+
+bool reads_this_or_from(sys::state const& state, dcon::value_modifier_key modifier) {
+	auto base = state.value_modifiers[modifier];
+	for(uint32_t i = 0; i < base.segments_count; ++i) {
+		auto seg = state.value_modifier_segments[base.first_segment_offset + i];
+		if(seg.condition && reads_this_or_from(state.trigger_data.data() + state.trigger_data_indices[seg.condition.index() + 1]))
+			return true;
+	}
+	return false;
+}
+
 } // namespace trigger
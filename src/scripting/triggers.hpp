@@ -192,4 +192,8 @@ ve::mask_vector evaluate(sys::state& state, dcon::trigger_key key, ve::contiguou
 		ve::contiguous_tags<int32_t> this_slot, int32_t from_slot);
 ve::mask_vector evaluate(sys::state& state, uint16_t const* data, ve::contiguous_tags<int32_t> primary,
 		ve::contiguous_tags<int32_t> this_slot, int32_t from_slot);
+
+// false when the value of the modifier can't depend on what is in the this and from slots, so that it may be evaluated once
+// and shared between all of them
+bool reads_this_or_from(sys::state const& state, dcon::value_modifier_key modifier);
 } // namespace trigger
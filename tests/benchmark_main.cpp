@@ -0,0 +1,120 @@
+#ifndef DCON_TRAP_INVALID_STORE
+#define DCON_TRAP_INVALID_STORE 1
+#endif
+
+#pragma comment(lib, "icu.lib")
+
+#define ALICE_NO_ENTRY_POINT 1
+#include "main.cpp"
+#include <webapi/json.hpp>
+
+using json = nlohmann::json;
+
+// Times the simulation over fixed spans from the same scenario and seed, and writes the per-phase timings as json so
+// that the results of two builds can be compared. Uses the same scenario file as the tests (tests_scenario.bin).
+//
+// Usage: benchmarks_project [output file] (defaults to tick_benchmark.json in the working directory)
+
+struct benchmark_span {
+	char const* name;
+	int32_t days;
+};
+
+static constexpr benchmark_span spans[] = {
+	{ "1 month", 31 },
+	{ "1 year", 365 },
+	{ "10 years", 3652 },
+};
+static constexpr uint32_t benchmark_seed = 808080;
+// the profiler only keeps the most recent samples of each thread, so they are collected before the buffers wrap around
+static constexpr int32_t days_per_collection = 30;
+
+static std::unique_ptr<sys::state> load_benchmark_scenario() {
+	std::unique_ptr<sys::state> game_state = std::make_unique<sys::state>(); // too big for the stack
+	add_root(game_state->common_fs, NATIVE("."));
+	if(!sys::try_read_scenario_and_save_file(*game_state, NATIVE("tests_scenario.bin")))
+		return nullptr;
+	game_state->fill_unsaved_data();
+	game_state->local_player_nation = dcon::nation_id{};
+	for(auto n : game_state->world.in_nation)
+		n.set_is_player_controlled(false);
+	game_state->user_settings.autosaves = sys::autosave_frequency::none;
+	game_state->game_seed = benchmark_seed;
+	return game_state;
+}
+
+int main(int argc, char** argv) {
+	std::string output_name = argc > 1 ? argv[1] : "tick_benchmark.json";
+
+	json out = json::object();
+	out["seed"] = benchmark_seed;
+	out["spans"] = json::array();
+
+	for(auto const& span : spans) {
+		auto game_state = load_benchmark_scenario();
+		if(!game_state) {
+			std::fprintf(stderr, "Could not read tests_scenario.bin; run the tests once to build it.\n");
+			return EXIT_FAILURE;
+		}
+
+		profiler::set_enabled(true);
+		profiler::clear();
+
+		std::vector<profiler::sample> samples;
+		std::vector<double> tick_ms;
+		for(int32_t i = 0; i < span.days; ++i) {
+			auto start = profiler::now();
+			game_state->single_game_tick();
+			tick_ms.push_back(double(profiler::now() - start) / 1'000'000.0);
+
+			while(game_state->new_messages.front())
+				game_state->new_messages.pop();
+
+			if((i + 1) % days_per_collection == 0 || i + 1 == span.days) {
+				auto collected = profiler::collect();
+				samples.insert(samples.end(), collected.begin(), collected.end());
+				profiler::clear();
+			}
+		}
+		profiler::set_enabled(false);
+
+		double total_ms = 0.0;
+		for(auto v : tick_ms)
+			total_ms += v;
+		auto checksum = game_state->get_save_checksum();
+
+		std::printf("%-10s %6d days %10.1f ms %8.2f ticks/s\n", span.name, int32_t(span.days), total_ms, total_ms > 0.0 ? double(span.days) * 1000.0 / total_ms : 0.0);
+
+		json j = json::object();
+		j["name"] = span.name;
+		j["days"] = span.days;
+		j["total_ms"] = total_ms;
+		j["ticks_per_second"] = total_ms > 0.0 ? double(span.days) * 1000.0 / total_ms : 0.0;
+		j["checksum"] = checksum.to_hex_string();
+		j["phases"] = json::array();
+		for(auto& p : profiler::summarize(samples)) {
+			json jp = json::object();
+			jp["name"] = p.name;
+			jp["count"] = p.count;
+			jp["min_ms"] = p.min_ms;
+			jp["mean_ms"] = p.mean_ms;
+			jp["p99_ms"] = p.p99_ms;
+			jp["max_ms"] = p.max_ms;
+			jp["total_ms"] = p.total_ms;
+			j["phases"].push_back(std::move(jp));
+		}
+		out["spans"].push_back(std::move(j));
+	}
+	auto text = out.dump(1, '\t') + "\n";
+
+	auto f = std::fopen(output_name.c_str(), "wb");
+	if(!f) {
+		std::fprintf(stderr, "Could not write %s\n", output_name.c_str());
+		return EXIT_FAILURE;
+	}
+	std::fwrite(text.data(), 1, text.size(), f);
+	std::fclose(f);
+	std::printf("Wrote %s\n", output_name.c_str());
+
+	return EXIT_SUCCESS;
+}
@@ -667,6 +667,138 @@ void checked_single_tick(sys::state& ws1, sys::state& ws2) {
 	compare_game_states(ws1, ws2);
 }
 
+TEST_CASE("pop_transfers_match_serial", "[determinism]") {
+	// gathering all of the pop creating changes first and applying them together must give the same result as applying
+	// each kind of change before gathering the next
+	std::unique_ptr<sys::state> game_state_1 = load_testing_scenario_file();
+	std::unique_ptr<sys::state> game_state_2 = load_testing_scenario_file();
+	game_state_2->game_seed = game_state_1->game_seed = 808080;
+
+	demographics::promotion_buffer pbuf_1, pbuf_2;
+	demographics::assimilation_buffer abuf_1, abuf_2;
+	demographics::migration_buffer mbuf_1, mbuf_2;
+	demographics::migration_buffer cmbuf_1, cmbuf_2;
+	demographics::migration_buffer imbuf_1, imbuf_2;
+	demographics::pop_transfer_list transfers[5];
+
+	for(int i = 0; i < 31; i++) {
+		game_state_1->current_date += 1;
+		game_state_2->current_date += 1;
+
+		auto ymd_date = game_state_1->current_date.to_ymd(game_state_1->start_date);
+		auto month_start = sys::year_month_day{ ymd_date.year, ymd_date.month, uint16_t(1) };
+		auto next_month_start = ymd_date.month != 12 ? sys::year_month_day{ ymd_date.year, uint16_t(ymd_date.month + 1), uint16_t(1) } : sys::year_month_day{ ymd_date.year + 1, uint16_t(1), uint16_t(1) };
+		auto const days_in_month = uint32_t(sys::days_difference(month_start, next_month_start));
+		auto offset = [&](uint32_t o) {
+			o += uint32_t(ymd_date.day);
+			return o >= days_in_month ? o - days_in_month : o;
+		};
+
+		demographics::update_type_changes(*game_state_1, offset(6), days_in_month, pbuf_1);
+		demographics::update_assimilation(*game_state_1, offset(7), days_in_month, abuf_1);
+		demographics::update_internal_migration(*game_state_1, offset(8), days_in_month, mbuf_1);
+		demographics::update_colonial_migration(*game_state_1, offset(9), days_in_month, cmbuf_1);
+		demographics::update_immigration(*game_state_1, offset(10), days_in_month, imbuf_1);
+
+		demographics::update_type_changes(*game_state_2, offset(6), days_in_month, pbuf_2);
+		demographics::update_assimilation(*game_state_2, offset(7), days_in_month, abuf_2);
+		demographics::update_internal_migration(*game_state_2, offset(8), days_in_month, mbuf_2);
+		demographics::update_colonial_migration(*game_state_2, offset(9), days_in_month, cmbuf_2);
+		demographics::update_immigration(*game_state_2, offset(10), days_in_month, imbuf_2);
+
+		demographics::apply_type_changes(*game_state_1, offset(6), days_in_month, pbuf_1);
+		demographics::apply_assimilation(*game_state_1, offset(7), days_in_month, abuf_1);
+		demographics::apply_internal_migration(*game_state_1, offset(8), days_in_month, mbuf_1);
+		demographics::apply_colonial_migration(*game_state_1, offset(9), days_in_month, cmbuf_1);
+		demographics::apply_immigration(*game_state_1, offset(10), days_in_month, imbuf_1);
+
+		demographics::gather_type_changes(*game_state_2, offset(6), days_in_month, pbuf_2, transfers[0]);
+		demographics::gather_assimilation(*game_state_2, offset(7), days_in_month, abuf_2, transfers[1]);
+		demographics::gather_internal_migration(*game_state_2, offset(8), days_in_month, mbuf_2, transfers[2]);
+		demographics::gather_colonial_migration(*game_state_2, offset(9), days_in_month, cmbuf_2, transfers[3]);
+		demographics::gather_immigration(*game_state_2, offset(10), days_in_month, imbuf_2, transfers[4]);
+		demographics::apply_pop_transfers(*game_state_2, transfers, 5);
+
+		demographics::remove_size_zero_pops(*game_state_1);
+		demographics::remove_size_zero_pops(*game_state_2);
+		compare_game_states(*game_state_1, *game_state_2);
+	}
+}
+
+TEST_CASE("cached_values_after_province_transfer", "[determinism]") {
+	// recomputing the cached values of only the nations that gained or lost a province must give the same values as
+	// recomputing them for every nation
+	std::unique_ptr<sys::state> game_state_1 = load_testing_scenario_file();
+	std::unique_ptr<sys::state> game_state_2 = load_testing_scenario_file();
+
+	for(auto gs : { game_state_1.get(), game_state_2.get() }) {
+		for(int32_t i = 0; i < gs->province_definitions.first_sea_province.index(); i += 97) {
+			dcon::province_id pid{ dcon::province_id::value_base_t(i) };
+			auto owner = gs->world.province_get_nation_from_province_ownership(pid);
+			for(auto adj : gs->world.province_get_province_adjacency(pid)) {
+				auto other = adj.get_connected_provinces(0) != pid ? adj.get_connected_provinces(0) : adj.get_connected_provinces(1);
+				auto other_owner = other.get_nation_from_province_ownership();
+				if(other_owner && other_owner != owner) {
+					province::change_province_owner(*gs, pid, other_owner);
+					break;
+				}
+			}
+		}
+		province::update_connected_regions(*gs);
+	}
+	REQUIRE(!game_state_1->nations_with_changed_provinces.empty());
+
+	province::update_cached_values(*game_state_1);
+	game_state_2->national_cached_values_out_of_date = true;
+	province::update_cached_values(*game_state_2);
+
+	for(auto n : game_state_1->world.in_nation) {
+		auto m = dcon::fatten(game_state_2->world, n.id);
+		REQUIRE(n.get_owned_province_count() == m.get_owned_province_count());
+		REQUIRE(n.get_central_province_count() == m.get_central_province_count());
+		REQUIRE(n.get_central_blockaded() == m.get_central_blockaded());
+		REQUIRE(n.get_central_rebel_controlled() == m.get_central_rebel_controlled());
+		REQUIRE(n.get_rebel_controlled_count() == m.get_rebel_controlled_count());
+		REQUIRE(n.get_central_ports() == m.get_central_ports());
+		REQUIRE(n.get_central_crime_count() == m.get_central_crime_count());
+		REQUIRE(n.get_total_ports() == m.get_total_ports());
+		REQUIRE(n.get_occupied_count() == m.get_occupied_count());
+		REQUIRE(n.get_owned_state_count() == m.get_owned_state_count());
+		REQUIRE(n.get_is_colonial_nation() == m.get_is_colonial_nation());
+		REQUIRE(n.get_capital().id == m.get_capital().id);
+	}
+	for(auto p : game_state_1->world.in_province) {
+		REQUIRE(p.get_is_owner_core() == game_state_2->world.province_get_is_owner_core(p.id));
+	}
+	for(auto s : game_state_1->world.in_state_instance) {
+		REQUIRE(s.get_capital().id == game_state_2->world.state_instance_get_capital(s.id));
+	}
+}
+
+TEST_CASE("budget_projections_match_estimates", "[determinism]") {
+	// the copies of the budget estimates made at the end of a tick must be the values the estimates compute directly
+	std::unique_ptr<sys::state> game_state = load_testing_scenario_file();
+	game_state->game_seed = 808080;
+	game_state->single_game_tick();
+	REQUIRE(game_state->budget_projections.ready.load());
+	REQUIRE(game_state->budget_projections.entries.size() == game_state->world.nation_size());
+
+	std::vector<economy::budget_projection> cached = game_state->budget_projections.entries;
+	economy::invalidate_budget_projections(*game_state);
+	for(auto n : game_state->world.in_nation) {
+		auto const& p = cached[n.id.index()];
+		REQUIRE(p.valid);
+		REQUIRE(p.daily_income == economy::estimate_daily_income(*game_state, n));
+		REQUIRE(p.tariff_import_income == economy::estimate_tariff_import_income(*game_state, n));
+		REQUIRE(p.social_spending == economy::estimate_social_spending(*game_state, n));
+		REQUIRE(p.pop_payouts[uint8_t(culture::income_type::education)] == economy::estimate_pop_payouts_by_income_type(*game_state, n, culture::income_type::education));
+		REQUIRE(p.land_spending == economy::estimate_land_spending(*game_state, n));
+		REQUIRE(p.construction_spending == economy::estimate_construction_spending(*game_state, n));
+		REQUIRE(p.subject_payments_paid == economy::estimate_subject_payments_paid(*game_state, n));
+		REQUIRE(p.subject_payments_received == economy::estimate_subject_payments_received(*game_state, n));
+	}
+}
+
 TEST_CASE("sim_none", "[determinism]") {
 	// Test that the game states are equal AFTER loading
 	std::unique_ptr<sys::state> game_state_1 = load_testing_scenario_file();
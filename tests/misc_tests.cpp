@@ -2,6 +2,9 @@
 #include "system_state.hpp"
 #include "date_interface.hpp"
 #include "cyto_any.hpp"
+#include "demographics.hpp"
+#include "economy_history.hpp"
+#include "serialization.hpp"
 /*
 TEST_CASE("string pool tests", "[misc_tests]") {
 	std::unique_ptr<sys::state> state = std::make_unique<sys::state>();
@@ -225,3 +228,141 @@ TEST_CASE("cyto payload tests", "[misc_tests]") {
 		REQUIRE(any_cast<void *>(vp_payload) == (void *)nullptr);
 	}
 }
+
+TEST_CASE("alias table tests", "[misc_tests]") {
+	std::vector<float> weights{ 1.0f, 2.0f, 3.0f, 4.0f, 0.5f };
+	demographics::alias_table table;
+	table.build(weights);
+	REQUIRE(table.size() == uint32_t(weights.size()));
+
+	// sweep the random values evenly: each index must come up in proportion to its weight
+	uint32_t const column_steps = 320; // a multiple of the number of weights
+	uint32_t const coin_steps = 1024;
+	std::vector<uint32_t> counts(weights.size(), 0);
+	for(uint32_t i = 0; i < column_steps; ++i) {
+		auto column_part = uint64_t((uint64_t(i) << 32) / column_steps) << 32;
+		for(uint32_t j = 0; j < coin_steps; ++j) {
+			auto coin_part = uint64_t(j) * 0x1000000 / coin_steps;
+			++counts[table.draw(column_part | coin_part)];
+		}
+	}
+	float const total_weight = 10.5f;
+	for(size_t k = 0; k < weights.size(); ++k) {
+		REQUIRE(float(counts[k]) / float(column_steps * coin_steps) == Approx(weights[k] / total_weight).margin(0.01));
+	}
+
+	demographics::alias_table single;
+	single.build(std::vector<float>{ 2.0f });
+	REQUIRE(single.draw(0) == 0);
+	REQUIRE(single.draw(~uint64_t(0)) == 0);
+}
+
+TEST_CASE("economy history block tests", "[misc_tests]") {
+	SECTION("encode_decode") {
+		// enough columns for two groups, with values that change by a little, a lot, or not at all
+		uint32_t const columns = economy_history::columns_per_group + 44;
+		std::vector<float> values(size_t(columns) * economy_history::block_length);
+		for(size_t i = 0; i < values.size(); ++i) {
+			auto column = uint32_t(i / economy_history::block_length);
+			auto row = uint32_t(i % economy_history::block_length);
+			switch(column % 4) {
+			case 0: values[i] = 1.5f + float(row) * 0.01f; break;
+			case 1: values[i] = float(column) * 1000.0f; break;
+			case 2: values[i] = (row % 2 == 0 ? -1.0f : 1.0f) * float(i) * 12345.678f; break;
+			default: values[i] = 0.0f; break;
+			}
+		}
+		auto b = economy_history::encode(values.data(), columns, 30, 7);
+		REQUIRE(b.first_date == 30);
+		REQUIRE(b.step == 7);
+		REQUIRE(b.columns == columns);
+		REQUIRE(b.group_offsets.size() == size_t(3));
+
+		std::vector<float> decoded;
+		economy_history::decode(b, decoded);
+		REQUIRE(decoded.size() == values.size());
+		REQUIRE(memcmp(decoded.data(), values.data(), values.size() * sizeof(float)) == 0);
+	}
+	SECTION("compaction") {
+		// every sample is its own date, so a sample of a merged block must be the mean of the dates it covers
+		uint32_t const columns = 3;
+		uint32_t const block_count = 40;
+		economy_history::table t;
+		std::vector<float> values(size_t(columns) * economy_history::block_length);
+		for(uint32_t k = 0; k < block_count; ++k) {
+			auto first_date = k * economy_history::block_length;
+			for(uint32_t c = 0; c < columns; ++c) {
+				for(uint32_t r = 0; r < economy_history::block_length; ++r)
+					values[size_t(c) * economy_history::block_length + r] = float(first_date + r);
+			}
+			t.sealed.push_back(economy_history::encode(values.data(), columns, uint16_t(first_date), 1));
+			economy_history::compact(t);
+
+			// the blocks still cover every day so far, in order, getting finer towards the present
+			uint32_t next_date = 0;
+			uint16_t last_step = t.sealed.front().step;
+			uint32_t same_step = 0;
+			for(auto const& b : t.sealed) {
+				REQUIRE(b.first_date == next_date);
+				REQUIRE(b.step <= last_step);
+				same_step = b.step == last_step ? same_step + 1 : 1;
+				REQUIRE(same_step <= economy_history::blocks_per_level);
+				last_step = b.step;
+				next_date = b.first_date + uint32_t(b.step) * economy_history::block_length;
+			}
+			REQUIRE(next_date == (k + 1) * economy_history::block_length);
+		}
+		REQUIRE(t.sealed.size() < size_t(block_count / 2));
+		REQUIRE(t.sealed.front().step > 1);
+
+		std::vector<float> decoded;
+		for(auto const& b : t.sealed) {
+			economy_history::decode(b, decoded);
+			for(uint32_t c = 0; c < columns; ++c) {
+				for(uint32_t r = 0; r < economy_history::block_length; ++r) {
+					auto first_covered = float(b.first_date + uint32_t(b.step) * r);
+					REQUIRE(decoded[size_t(c) * economy_history::block_length + r] == first_covered + float(b.step - 1) * 0.5f);
+				}
+			}
+		}
+	}
+	SECTION("serialization") {
+		economy_history::store s;
+		auto& t = s.tables[uint8_t(economy_history::series::treasury)];
+		t.columns = 2;
+		t.open_first_date = 64;
+		t.open_rows = 3;
+		t.open_values.assign(size_t(t.columns) * economy_history::block_length, 0.0f);
+		for(uint32_t r = 0; r < t.open_rows; ++r) {
+			t.open_values[r] = float(r) + 0.25f;
+			t.open_values[economy_history::block_length + r] = -float(r);
+		}
+		std::vector<float> values(size_t(t.columns) * economy_history::block_length, 2.0f);
+		t.sealed.push_back(economy_history::encode(values.data(), t.columns, 0, 2));
+
+		std::vector<uint8_t> buffer(economy_history::serialize_size(s));
+		auto end = economy_history::serialize(buffer.data(), s);
+		REQUIRE(size_t(end - buffer.data()) == buffer.size());
+
+		economy_history::store loaded;
+		auto read_end = economy_history::deserialize(buffer.data(), loaded);
+		REQUIRE(read_end == buffer.data() + buffer.size());
+		for(size_t k = 0; k < s.tables.size(); ++k) {
+			auto const& a = s.tables[k];
+			auto const& b = loaded.tables[k];
+			REQUIRE(a.cadence == b.cadence);
+			REQUIRE(a.columns == b.columns);
+			REQUIRE(a.open_first_date == b.open_first_date);
+			REQUIRE(a.open_rows == b.open_rows);
+			REQUIRE(a.open_values == b.open_values);
+			REQUIRE(a.sealed.size() == b.sealed.size());
+			for(size_t i = 0; i < a.sealed.size(); ++i) {
+				REQUIRE(a.sealed[i].first_date == b.sealed[i].first_date);
+				REQUIRE(a.sealed[i].step == b.sealed[i].step);
+				REQUIRE(a.sealed[i].columns == b.sealed[i].columns);
+				REQUIRE(a.sealed[i].group_offsets == b.sealed[i].group_offsets);
+				REQUIRE(a.sealed[i].data == b.sealed[i].data);
+			}
+		}
+	}
+}